@@ -0,0 +1,54 @@
+#!/usr/bin/perl
+
+use strict;
+use warnings;
+use JSON::PP;
+
+# check_json.pl
+#
+# checks that the output of the tests run with --json-ui is one
+# JSON document; run after test.pl, in the same directory
+
+sub load($) {
+  my ($fname) = @_;
+
+  open FILE, "<$fname" or return undef;
+  my @data = grep { !/^\/\// } <FILE>;
+  close FILE;
+
+  chomp @data;
+  return @data;
+}
+
+my @tests = @ARGV;
+
+if(@tests == 0) {
+  opendir CWD, ".";
+  @tests = sort grep { !/^\./ && -d "$_" && -s "$_/test.desc" } readdir CWD;
+  closedir CWD;
+}
+
+my $failures = 0;
+
+foreach my $test (@tests) {
+  my ($level, $input, $options) = load("$test/test.desc");
+
+  next if(!defined($options) || $options !~ /--json-ui/);
+
+  my $output = $input;
+  $output =~ s/\.(v|sv|smv|c|i|cpp|ii|xml|vhd)$/.out/;
+
+  # test.pl appends the exit code and the signal
+  my @lines = grep { !/^(EXIT|SIGNAL)=[0-9]+$/ } load("$test/$output");
+
+  print "  Checking $test";
+
+  if(eval { decode_json(join("\n", @lines)); 1 }) {
+    print "  [OK]\n";
+  } else {
+    print "  [FAILED]\n";
+    $failures++;
+  }
+}
+
+exit $failures;
@@ -0,0 +1,16 @@
+module main(input clk);
+
+  parameter WIDTH=8;
+
+  // the range is elaborated once, and then found in the cache
+  reg [WIDTH-1:0] a;
+  reg [WIDTH-1:0] b;
+  reg [WIDTH-1:0] c;
+
+  initial a=0;
+  initial b=0;
+  initial c=0;
+
+  always assert p1: a==b && b==c;
+
+endmodule
@@ -0,0 +1,22 @@
+module main(input clk);
+
+  reg [7:0] mem[0:4095];
+  integer i;
+
+  initial
+    for(i=0; i<4096; i=i+1)
+      mem[i]=i;
+
+  always @(posedge clk)
+    for(i=0; i<2048; i=i+1)
+      mem[i]<=mem[i]+1;
+
+  // written by the loop
+  always assert p1: mem[100]==8'd100;
+  always assert p2: mem[100]<=8'd103;
+  always assert p3: mem[2047]==mem[100]+8'd155;
+
+  // just past the loop, unchanged
+  always assert p4: mem[2048]==8'd0;
+
+endmodule
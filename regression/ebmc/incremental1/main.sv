@@ -0,0 +1,16 @@
+module main(input [7:0] in);
+
+  reg [7:0] x, y;
+  wire clk;
+
+  initial x=0;
+  initial y=0;
+
+  always @(posedge clk) x<=x;
+  always @(posedge clk) y<=in & 8'h07;
+
+  always assert p_x: x==0;
+
+  always assert p_y: y<=7;
+
+endmodule
@@ -0,0 +1,18 @@
+module main(input [7:0] in);
+
+  reg [7:0] x, y;
+  wire clk;
+
+  initial x=0;
+  initial y=0;
+
+  always @(posedge clk) x<=x;
+  always @(posedge clk) y<=in & 8'h0f;
+
+  // the cone is the same as in incremental1
+  always assert p_x: x==0;
+
+  // the cone differs from the one in incremental1
+  always assert p_y: y<=7;
+
+endmodule
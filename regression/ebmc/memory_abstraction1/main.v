@@ -0,0 +1,20 @@
+module main(input clk, input we, input [3:0] addr, input [7:0] data);
+
+  reg [7:0] mem [0:15];
+  reg [3:0] last_addr;
+  reg [7:0] last_data;
+  reg valid=0;
+
+  always @(posedge clk) begin
+    if(we) mem[addr] <= data;
+    last_addr <= addr;
+    last_data <= data;
+    valid <= we;
+  end
+
+  wire [7:0] out = mem[last_addr];
+
+  // we read what was written in the previous cycle
+  assert property (valid |-> out==last_data);
+
+endmodule
@@ -0,0 +1,9 @@
+module counter(input clk, output reg [7:0] out);
+
+  initial out=0;
+
+  always @(posedge clk)
+    if(out<100)
+      out=out+1;
+
+endmodule
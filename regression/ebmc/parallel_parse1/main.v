@@ -0,0 +1,9 @@
+module main(input clk);
+
+  wire [7:0] out;
+
+  counter c(clk, out);
+
+  always assert p1: out!=200;
+
+endmodule
@@ -180,7 +180,10 @@ int bdd_enginet::operator()()
     }
 
     for(propertyt &p : properties)
+    {
       check_property(p);
+      stream_result(p);
+    }
     
     report_results();
 
@@ -384,7 +387,7 @@ void bdd_enginet::compute_counterexample(
     bmc_map,
     solver,
     ns,
-    property.counterexample);
+    property.packed_counterexample);
 }
 
 /*******************************************************************\
@@ -401,7 +404,7 @@ Function: bdd_enginet::check_property
 
 void bdd_enginet::check_property(propertyt &property)
 {
-  if(property.is_disabled())
+  if(property.is_skipped())
     return;
 
   status() << "Checking " << property.name << eom;
@@ -431,6 +434,13 @@ void bdd_enginet::check_property(propertyt &property)
 
     while(true)
     {
+      if(out_of_resources() ||
+         limits.bdd_nodes_exhausted(mgr.number_of_nodes(), limit_reason))
+      {
+        status() << "Property undecided (" << limit_reason << ")" << eom;
+        break;
+      }
+
       iteration++;
       statistics() << "Iteration " << iteration << eom;
 
@@ -449,6 +459,9 @@ void bdd_enginet::check_property(propertyt &property)
         compute_counterexample(property, iteration);
         break;
       }
+
+      // no initial state reaches !p in fewer than 'iteration' steps
+      property.bound_reached=iteration-1;
       
       // make the states be expressed in terms of 'next' variables
       BDD states_next=current_to_next(states);
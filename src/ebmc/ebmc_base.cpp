@@ -6,12 +6,16 @@ Author: Daniel Kroening, kroening@kroening.com
 
 \*******************************************************************/
 
+#include <atomic>
 #include <chrono>
 #include <fstream>
 #include <iostream>
+#include <sstream>
+#include <thread>
 
 #include <util/cmdline.h>
 #include <util/config.h>
+#include <util/ebmc_util.h>
 #include <util/expr_util.h>
 #include <util/find_macros.h>
 #include <util/get_module.h>
@@ -34,8 +38,11 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <langapi/language_util.h>
 #include <langapi/mode.h>
 
+#include <verilog/verilog_language.h>
+
 #include "ebmc_base.h"
 #include "ebmc_version.h"
+#include "proof_cache.h"
 
 /*******************************************************************\
 
@@ -72,7 +79,8 @@ Function: ebmc_baset::ebmc_baset
 ebmc_baset::ebmc_baset(const cmdlinet &_cmdline,
                        ui_message_handlert &_ui_message_handler)
     : messaget(_ui_message_handler), symbol_table{}, cmdline(_cmdline),
-      main_symbol(NULL) {
+      main_symbol(NULL), limits(_cmdline), limited_solver(nullptr),
+      bmc_results_final(true) {
   if(cmdline.isset("verbosity"))
     message_handler->set_verbosity(
         unsafe_string2unsigned(cmdline.get_value("verbosity")));
@@ -82,6 +90,37 @@ ebmc_baset::ebmc_baset(const cmdlinet &_cmdline,
 
 /*******************************************************************\
 
+Function: ebmc_baset::out_of_resources
+
+  Inputs:
+
+ Outputs: true if the engine has to stop
+
+ Purpose: Once a limit is reached, this stays true.
+          Otherwise, the SAT solver is given the time that
+          is left for its next call.
+
+\*******************************************************************/
+
+bool ebmc_baset::out_of_resources()
+{
+  if(!limit_reason.empty())
+    return true;
+
+  if(!limits.exhausted(limit_reason))
+  {
+    if(limited_solver!=nullptr)
+      limits.limit_solver(*limited_solver);
+
+    return false;
+  }
+
+  warning() << "Resource limit reached (" << limit_reason << ")" << eom;
+  return true;
+}
+
+/*******************************************************************\
+
 Function: ebmc_baset::finish_bmc
 
   Inputs:
@@ -97,7 +136,7 @@ int ebmc_baset::finish_bmc(prop_conv_solvert &solver) {
   
   for(propertyt &property : properties)
   {
-    if(property.is_disabled())
+    if(property.is_skipped())
       continue;
     
     const namespacet ns(symbol_table);
@@ -119,8 +158,11 @@ int ebmc_baset::finish_bmc(prop_conv_solvert &solver) {
   
   for(propertyt &property : properties)
   {
-    if(property.is_disabled())
+    if(property.is_skipped())
       continue;
+
+    if(out_of_resources())
+      break;
     
     status() << "Checking " << property.name << eom;
     
@@ -160,9 +202,13 @@ int ebmc_baset::finish_bmc(prop_conv_solvert &solver) {
       result() << "UNSAT: No counterexample found within bound"
                << messaget::eom;
       property.make_success();
+      property.bound_reached=bound;
       break;
 
     case decision_proceduret::resultt::D_ERROR:
+      // the solver was interrupted
+      if(out_of_resources())
+        break;
       error() << "Error from decision procedure" << messaget::eom;
       return 2;
 
@@ -170,8 +216,13 @@ int ebmc_baset::finish_bmc(prop_conv_solvert &solver) {
       error() << "Unexpected result from decision procedure" << messaget::eom;
       return 1;
     }
+
+    if(property.is_failure() || bmc_results_final)
+      stream_result(property);
   }
 
+  stream_bound();
+
   auto sat_stop_time = std::chrono::steady_clock::now();
 
   statistics()
@@ -179,6 +230,9 @@ int ebmc_baset::finish_bmc(prop_conv_solvert &solver) {
      << std::chrono::duration<double>(sat_stop_time-sat_start_time).count()
      << eom;
 
+  stream_statistics(
+    std::chrono::duration<double>(sat_stop_time-sat_start_time).count());
+
   // We return '0' if the property holds,
   // and '10' if it is violated.
   return property_failure()?10:0; 
@@ -201,7 +255,7 @@ int ebmc_baset::finish_bmc(const bmc_mapt &bmc_map, propt &solver)
   // convert the properties
   for(propertyt &property : properties)
   {
-    if(property.is_disabled())
+    if(property.is_skipped())
       continue;
     
     const namespacet ns(symbol_table);
@@ -220,9 +274,12 @@ int ebmc_baset::finish_bmc(const bmc_mapt &bmc_map, propt &solver)
 
   for(propertyt &property : properties)
   {
-    if(property.is_disabled())
+    if(property.is_skipped())
       continue;
 
+    if(out_of_resources())
+      break;
+
     status() << "Checking " << property.name << messaget::eom;
 
     literalt property_literal=!solver.land(property.timeframe_literals);
@@ -248,7 +305,7 @@ int ebmc_baset::finish_bmc(const bmc_mapt &bmc_map, propt &solver)
           bmc_map,
           solver,
           ns,
-          property.counterexample);
+          property.packed_counterexample);
       }
       break;
 
@@ -256,9 +313,13 @@ int ebmc_baset::finish_bmc(const bmc_mapt &bmc_map, propt &solver)
       result() << "UNSAT: No counterexample found within bound"
                << messaget::eom;
       property.make_success();
+      property.bound_reached=bound;
       break;
 
     case propt::resultt::P_ERROR:
+      // the solver was interrupted
+      if(out_of_resources())
+        break;
       error() << "Error from decision procedure" << messaget::eom;
       return 2;
 
@@ -266,8 +327,13 @@ int ebmc_baset::finish_bmc(const bmc_mapt &bmc_map, propt &solver)
       error() << "Unexpected result from decision procedure" << messaget::eom;
       return 1;
     }
+
+    if(property.is_failure() || bmc_results_final)
+      stream_result(property);
   }
 
+  stream_bound();
+
   auto sat_stop_time = std::chrono::steady_clock::now();  
     
   statistics()
@@ -275,6 +341,9 @@ int ebmc_baset::finish_bmc(const bmc_mapt &bmc_map, propt &solver)
     << std::chrono::duration<double>(sat_stop_time-sat_start_time).count()
     << eom;
 
+  stream_statistics(
+    std::chrono::duration<double>(sat_stop_time-sat_start_time).count());
+
   // We return '0' if the property holds,
   // and '10' if it is violated.
   return property_failure()?10:0; 
@@ -569,6 +638,246 @@ int ebmc_baset::do_bmc(prop_conv_solvert &solver, bool convert_only) {
 
 /*******************************************************************\
 
+Function: ebmc_baset::finish_word_level_bmc
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: Checks the properties one by one using push/pop,
+          keeping the unwinding. Properties that failed with
+          a smaller bound are not checked again.
+
+\*******************************************************************/
+
+int ebmc_baset::finish_word_level_bmc(
+  stack_decision_proceduret &solver,
+  bool convert_only)
+{
+  const namespacet ns(symbol_table);
+
+  for(propertyt &property : properties)
+  {
+    if(property.is_skipped() || property.is_failure())
+      continue;
+
+    ::property(property.expr, property.timeframe_handles,
+               get_message_handler(), solver, bound+1, ns);
+  }
+
+  if(!convert_only)
+    status() << "Solving with "
+             << solver.decision_procedure_text() << eom;
+
+  auto sat_start_time = std::chrono::steady_clock::now();
+
+  for(propertyt &property : properties)
+  {
+    if(property.is_skipped() || property.is_failure())
+      continue;
+
+    if(!convert_only && out_of_resources())
+      break;
+
+    if(!convert_only)
+      status() << "Checking " << property.name << eom;
+
+    exprt::operandst disjuncts;
+
+    for(const auto &h : property.timeframe_handles)
+      disjuncts.push_back(not_exprt(h));
+
+    // the assumptions must be literals
+    solver.push({solver.handle(disjunction(disjuncts))});
+
+    // when only converting, this writes the check-sat
+    decision_proceduret::resultt dec_result=
+      solver.dec_solve();
+
+    if(convert_only)
+    {
+      solver.pop();
+      continue;
+    }
+
+    switch(dec_result)
+    {
+    case decision_proceduret::resultt::D_SATISFIABLE:
+      {
+        property.make_failure();
+        result() << "SAT: counterexample found" << messaget::eom;
+
+        trans_tracet &trace=property.counterexample;
+
+        compute_trans_trace(
+          solver,
+          bound+1,
+          ns,
+          main_symbol->name,
+          trace);
+
+        for(std::size_t t=0; t<trace.states.size(); t++)
+          trace.states[t].property_failed=
+            solver.get(property.timeframe_handles[t]).is_false();
+      }
+      break;
+
+    case decision_proceduret::resultt::D_UNSATISFIABLE:
+      result() << "UNSAT: No counterexample found within bound"
+               << messaget::eom;
+      property.make_success();
+      property.bound_reached=bound;
+      break;
+
+    case decision_proceduret::resultt::D_ERROR:
+      // the solver was interrupted
+      if(out_of_resources())
+        break;
+      solver.pop();
+      error() << "Error from decision procedure" << messaget::eom;
+      return 2;
+
+    default:
+      solver.pop();
+      error() << "Unexpected result from decision procedure" << messaget::eom;
+      return 1;
+    }
+
+    solver.pop();
+
+    if(property.is_failure() || bmc_results_final)
+      stream_result(property);
+  }
+
+  if(convert_only)
+    return 0;
+
+  stream_bound();
+
+  auto sat_stop_time = std::chrono::steady_clock::now();
+
+  statistics()
+     << "Solver time: "
+     << std::chrono::duration<double>(sat_stop_time-sat_start_time).count()
+     << eom;
+
+  stream_statistics(
+    std::chrono::duration<double>(sat_stop_time-sat_start_time).count());
+
+  return property_failure()?10:0;
+}
+
+/*******************************************************************\
+
+Function: ebmc_baset::do_word_level_bmc
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: With --max-bound, the unwinding is deepened one
+          timeframe at a time in the same solver.
+
+\*******************************************************************/
+
+int ebmc_baset::do_word_level_bmc(
+  stack_decision_proceduret &solver,
+  bool convert_only)
+{
+  int result=0;
+
+  try
+  {
+    const namespacet ns(symbol_table);
+    CHECK_RETURN(trans_expr.has_value());
+
+    if(cmdline.isset("max-bound"))
+    {
+      if(convert_only)
+        throw "please set a specific bound";
+
+      if(properties.empty())
+        throw "no properties";
+
+      const unsigned max_bound=
+        unsafe_string2unsigned(cmdline.get_value("max-bound"));
+
+      unsigned no_timeframes=0;
+
+      // a property may still fail with a larger bound
+      bmc_results_final=false;
+
+      for(bound=1; bound<=max_bound; bound++)
+      {
+        if(out_of_resources())
+          break;
+
+        status() << "Doing BMC with bound " << bound << eom;
+
+        for(; no_timeframes<bound+1; no_timeframes++)
+          ::unwind_timeframe(*trans_expr, solver, no_timeframes, ns);
+
+        result=finish_word_level_bmc(solver, false);
+
+        if(result!=0 && result!=10)
+          return result;
+
+        bool all_failed=true;
+
+        for(const propertyt &property : properties)
+          if(!property.is_skipped() && !property.is_failure())
+            all_failed=false;
+
+        if(all_failed)
+          break;
+      }
+
+      if(bound>max_bound)
+        bound=max_bound;
+
+      report_results();
+    }
+    else
+    {
+      if(get_bound()) return 1;
+
+      if(!convert_only)
+        if(properties.empty())
+          throw "no properties";
+
+      status() << "Generating Decision Problem" << eom;
+
+      ::unwind(*trans_expr, *message_handler, solver, bound + 1, ns, true);
+
+      result=finish_word_level_bmc(solver, convert_only);
+
+      if(!convert_only)
+        report_results();
+    }
+  }
+
+  catch(const char *e)
+  {
+    error() << e << eom;
+    return 10;
+  }
+
+  catch(const std::string &e)
+  {
+    error() << e << eom;
+    return 10;
+  }
+
+  catch(int)
+  {
+    return 10;
+  }
+
+  return result;
+}
+
+/*******************************************************************\
+
 Function: ebmc_baset::do_bmc
 
   Inputs:
@@ -594,7 +903,7 @@ int ebmc_baset::do_bmc(cnft &solver, bool convert_only)
         throw "no properties";
       
     netlistt netlist;
-    if(make_netlist(netlist))
+    if(make_netlist(netlist, cmdline.isset("memory-abstraction")))
       throw 0;
 
     status() << "Unwinding Netlist" << eom;
@@ -646,9 +955,9 @@ Function: ebmc_baset::get_model
 
 int ebmc_baset::get_model()
 {
-  // do -I
-  if(cmdline.isset('I'))
-    config.verilog.include_paths=cmdline.get_values('I');
+  // do -I, also when not given, as a job of --batch
+  // must not use the paths of the previous one
+  config.verilog.include_paths=cmdline.get_values('I');
 
   //
   // parsing
@@ -768,12 +1077,168 @@ int ebmc_baset::get_model()
     std::cout << "}\n";
     return 0;
   }
+
+  if(cmdline.isset("incremental"))
+  {
+    if(reuse_results())
+      return 1;
+
+    bool all_reused=!properties.empty();
+
+    for(const auto &p : properties)
+      if(!p.is_skipped())
+        all_reused=false;
+
+    if(all_reused)
+    {
+      report_results();
+      return 0;
+    }
+  }
   
   return -1; // done with the model
 }
 
 /*******************************************************************\
 
+Function: ebmc_baset::reuse_results
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: take the results of earlier runs for the properties
+          whose cone of influence is unchanged
+
+\*******************************************************************/
+
+bool ebmc_baset::reuse_results()
+{
+  proof_cachet proof_cache;
+  const std::string file_name=cmdline.get_value("incremental");
+
+  if(proof_cache.read(file_name))
+  {
+    error() << "failed to read `" << file_name << "'" << eom;
+    return true;
+  }
+
+  CHECK_RETURN(trans_expr.has_value());
+
+  // a bounded result only helps BMC with the same or a smaller bound
+  const bool bmc=!proof_engine() &&
+                 !cmdline.isset("interpolation") &&
+                 !cmdline.isset("interpolation-word") &&
+                 !cmdline.isset("interpolation-vmcai");
+  // with --max-bound, the deepest bound is the one asked for
+  const unsigned current_bound=
+    cmdline.isset("max-bound")?
+      unsafe_string2unsigned(cmdline.get_value("max-bound")):
+    cmdline.isset("bound")?
+      unsafe_string2unsigned(cmdline.get_value("bound")):1;
+
+  std::size_t reused=0;
+
+  for(propertyt &property : properties)
+  {
+    if(property.is_disabled())
+      continue;
+
+    property.fingerprint=
+      proof_cachet::fingerprint(*trans_expr, property.expr);
+
+    const proof_cachet::entryt *entry=
+      proof_cache.find(property.fingerprint);
+
+    if(entry==nullptr)
+      continue;
+
+    if(entry->proved || (bmc && entry->bound>=current_bound))
+    {
+      debug() << "Reusing the result for " << property.name << eom;
+      property.make_success();
+      property.reused=true;
+      reused++;
+    }
+  }
+
+  status() << "Reusing results for " << reused << " of "
+           << properties.size() << " properties" << eom;
+
+  return false;
+}
+
+/*******************************************************************\
+
+Function: ebmc_baset::proof_engine
+
+  Inputs:
+
+ Outputs: true if a success of the engine of this run is a proof
+
+ Purpose:
+
+\*******************************************************************/
+
+bool ebmc_baset::proof_engine() const
+{
+  return cmdline.isset("k-induction") ||
+         cmdline.isset("bdd") ||
+         cmdline.isset("ic3");
+}
+
+/*******************************************************************\
+
+Function: ebmc_baset::store_results
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void ebmc_baset::store_results()
+{
+  proof_cachet proof_cache;
+  const std::string file_name=cmdline.get_value("incremental");
+
+  // keep the entries of the other properties
+  if(proof_cache.read(file_name))
+    proof_cache.entries.clear();
+
+  const bool proof=proof_engine();
+
+  for(const propertyt &property : properties)
+  {
+    if(property.is_skipped() ||
+       property.fingerprint.empty())
+      continue;
+
+    if(property.status==propertyt::statust::SUCCESS)
+    {
+      if(proof)
+        proof_cache.proved(property.fingerprint);
+      else
+        proof_cache.bounded(
+          property.fingerprint,
+          property.bound_reached?*property.bound_reached:bound);
+    }
+    else if(property.status==propertyt::statust::UNKNOWN &&
+            property.bound_reached)
+    {
+      // e.g., stopped by a resource limit
+      proof_cache.bounded(property.fingerprint, *property.bound_reached);
+    }
+  }
+
+  if(proof_cache.write(file_name))
+    warning() << "failed to write `" << file_name << "'" << eom;
+}
+
+/*******************************************************************\
+
 Function: ebmc_baset::show_ldg
 
   Inputs:
@@ -844,14 +1309,93 @@ Function: ebmc_baset::make_netlist
 \*******************************************************************/
 
 bool ebmc_baset::make_netlist(netlistt &netlist)
+{
+  return make_netlist(netlist, false);
+}
+
+/*******************************************************************\
+
+Function: property_symbols
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+static void property_symbols(
+  const exprt &expr,
+  std::set<irep_idt> &dest)
+{
+  if(expr.id()==ID_symbol || expr.id()==ID_next_symbol)
+    dest.insert(expr.get(ID_identifier));
+  else
+  {
+    forall_operands(it, expr)
+      property_symbols(*it, dest);
+  }
+}
+
+/*******************************************************************\
+
+Function: ebmc_baset::get_memories
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: the state variables of array type that no property
+          refers to
+
+\*******************************************************************/
+
+void ebmc_baset::get_memories(std::set<irep_idt> &memories)
+{
+  std::set<irep_idt> in_properties;
+
+  for(const auto &property : properties)
+    property_symbols(property.expr, in_properties);
+
+  auto add_memory=[&memories, &in_properties](const symbolt &symbol)
+  {
+    if(symbol.is_state_var &&
+       symbol.type.id()==ID_array &&
+       in_properties.find(symbol.name)==in_properties.end())
+      memories.insert(symbol.name);
+  };
+
+  for_all_module_symbols(symbol_table, main_symbol->name, add_memory);
+}
+
+/*******************************************************************\
+
+Function: ebmc_baset::make_netlist
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: with abstract_memories, memories are kept as ports
+          instead of latches; only the unwinding handles these
+
+\*******************************************************************/
+
+bool ebmc_baset::make_netlist(netlistt &netlist, bool abstract_memories)
 {
   // make net-list
   status() << "Generating Netlist" << eom;
 
   try
   {
+    std::set<irep_idt> memories;
+
+    if(abstract_memories)
+      get_memories(memories);
+
     convert_trans_to_netlist(
-      symbol_table, main_symbol->name,
+      symbol_table, main_symbol->name, memories,
       netlist, get_message_handler());
   }
   
@@ -918,7 +1462,7 @@ void ebmc_baset::report_results()
 
   if (static_cast<ui_message_handlert *>(message_handler)->get_ui() ==
       ui_message_handlert::uit::XML_UI) {
-    for(const propertyt &property : properties)
+    for(propertyt &property : properties)
     {
       if(property.status==propertyt::statust::DISABLED)
         continue;
@@ -933,19 +1477,32 @@ void ebmc_baset::report_results()
       case propertyt::statust::UNKNOWN: xml_result.set_attribute("status", "UNKNOWN"); break;
       case propertyt::statust::DISABLED:;
       }
+
+      if(property.bound_reached)
+        xml_result.set_attribute(
+          "bound", std::to_string(*property.bound_reached));
       
       if(property.is_failure())
-        convert(ns, property.counterexample, xml_result.new_element());
+        convert(ns, property.get_counterexample(ns), xml_result.new_element());
 
       std::cout << xml_result << '\n' << std::flush;
     }
   }
+  else if(json_ui())
+  {
+    // those that were not streamed when they were decided
+    for(propertyt &property : properties)
+      stream_result(property);
+  }
   else
   {
     status() << eom;
     status() << "** Results:" << eom;
 
-    for(const propertyt &property : properties)
+    if(!limit_reason.empty())
+      status() << "Resource limit reached (" << limit_reason << ")" << eom;
+
+    for(propertyt &property : properties)
     {
       if(property.status==propertyt::statust::DISABLED)
         continue;
@@ -960,6 +1517,11 @@ void ebmc_baset::report_results()
       case propertyt::statust::UNKNOWN: status() << "UNKNOWN"; break;
       case propertyt::statust::DISABLED:;
       }
+
+      if(property.status==propertyt::statust::UNKNOWN &&
+         property.bound_reached)
+        status() << " (no counterexample up to bound "
+                 << *property.bound_reached << ")";
                
       status() << eom;
       
@@ -968,12 +1530,15 @@ void ebmc_baset::report_results()
       {
         status() << "Counterexample:\n" << eom;
         show_trans_trace(
-            property.counterexample, *this, ns,
+            property.get_counterexample(ns), *this, ns,
             static_cast<ui_message_handlert *>(message_handler)->get_ui());
       }
     }
   }
 
+  if(cmdline.isset("incremental"))
+    store_results();
+
   if(cmdline.isset("vcd"))
   {
     for(const propertyt &property : properties)
@@ -987,11 +1552,18 @@ void ebmc_baset::report_results()
         std::ofstream vcd(vcdfile);
         #endif
 
-        show_trans_trace_vcd(
-          property.counterexample,
-          *this, // message
-          ns,
-          vcd);
+        if(!property.packed_counterexample.empty())
+          show_trans_trace_vcd(
+            property.packed_counterexample,
+            *this, // message
+            ns,
+            vcd);
+        else
+          show_trans_trace_vcd(
+            property.counterexample,
+            *this, // message
+            ns,
+            vcd);
 
         break;
       }
@@ -1001,6 +1573,14 @@ void ebmc_baset::report_results()
 }
 
 bool ebmc_baset::parse() {
+  unsigned num_threads = 1;
+
+  if (cmdline.isset("num-threads"))
+    num_threads = unsafe_string2unsigned(cmdline.get_value("num-threads"));
+
+  if (num_threads > 1 && cmdline.args.size() > 1)
+    return parse_parallel(num_threads);
+
   for (unsigned i = 0; i < cmdline.args.size(); i++) {
     if (parse(cmdline.args[i]))
       return true;
@@ -1008,6 +1588,175 @@ bool ebmc_baset::parse() {
   return false;
 }
 
+/*******************************************************************\
+
+   Class: buffered_message_handlert
+
+ Purpose: keeps the messages of a worker thread until they
+          can be replayed in order
+
+\*******************************************************************/
+
+class buffered_message_handlert : public message_handlert {
+public:
+  void print(unsigned level, const std::string &message) override {
+    message_handlert::print(level, message);
+    messages.emplace_back(level, message);
+  }
+
+  void flush(unsigned) override {}
+
+  void replay(message_handlert &dest) const {
+    for (const auto &m : messages)
+      dest.print(m.first, m.second);
+  }
+
+protected:
+  std::vector<std::pair<unsigned, std::string>> messages;
+};
+
+/*******************************************************************\
+
+Function: ebmc_baset::parse_parallel
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: Verilog files are preprocessed on a pool of threads;
+          the parse trees are then built in command-line order,
+          as the parser is not re-entrant.
+
+\*******************************************************************/
+
+bool ebmc_baset::parse_parallel(unsigned num_threads) {
+  struct filet {
+    std::string filename;
+    std::unique_ptr<languaget> language;
+    verilog_languaget *verilog;
+    buffered_message_handlert message_handler;
+    std::string preprocessed;
+    bool failed;
+  };
+
+  std::vector<filet> files(cmdline.args.size());
+
+  for (std::size_t i = 0; i < files.size(); i++) {
+    filet &file = files[i];
+    file.filename = cmdline.args[i];
+    file.language = get_language_from_filename(file.filename);
+    file.failed = false;
+
+    if (file.language == nullptr) {
+      source_locationt location;
+      location.set_file(file.filename);
+      error().source_location = location;
+      error() << "failed to figure out type of file" << eom;
+      return true;
+    }
+
+    file.verilog = dynamic_cast<verilog_languaget *>(file.language.get());
+  }
+
+  const std::size_t no_workers =
+      std::min(std::size_t(num_threads), files.size());
+
+  std::atomic<std::size_t> next_file(0);
+  std::vector<std::thread> threads;
+
+  for (std::size_t w = 0; w < no_workers; w++) {
+    threads.push_back(std::thread([&files, &next_file]() {
+      for (std::size_t i = next_file++; i < files.size(); i = next_file++) {
+        filet &file = files[i];
+
+        // others are done in the second pass
+        if (file.verilog == nullptr)
+          continue;
+
+#ifdef _MSC_VER
+        std::ifstream infile(widen(file.filename));
+#else
+        std::ifstream infile(file.filename);
+#endif
+
+        // reported in the second pass
+        if (!infile)
+          continue;
+
+        file.verilog->set_message_handler(file.message_handler);
+
+        try {
+          std::ostringstream out;
+          file.failed = file.verilog->preprocess(infile, file.filename, out);
+          file.preprocessed = out.str();
+        }
+
+        catch (const char *e) {
+          messaget(file.message_handler).error() << e << eom;
+          file.failed = true;
+        }
+
+        catch (const std::string &e) {
+          messaget(file.message_handler).error() << e << eom;
+          file.failed = true;
+        }
+      }
+    }));
+  }
+
+  for (auto &thread : threads)
+    thread.join();
+
+  // merge in the order given on the command line
+  for (auto &file : files) {
+#ifdef _MSC_VER
+    std::ifstream infile(widen(file.filename));
+#else
+    std::ifstream infile(file.filename);
+#endif
+
+    if (!infile) {
+      error() << "failed to open input file `" << file.filename << "'"
+              << eom;
+      return true;
+    }
+
+    file.message_handler.replay(get_message_handler());
+
+    languaget &language = *file.language;
+    language.set_message_handler(get_message_handler());
+
+    status() << "Parsing " << file.filename << eom;
+
+    bool result;
+
+    if (file.verilog == nullptr)
+      result = language.parse(infile, file.filename);
+    else
+      result = file.failed ||
+               file.verilog->parse_preprocessed(file.preprocessed,
+                                                file.filename);
+
+    // not needed anymore
+    std::string().swap(file.preprocessed);
+
+    if (result) {
+      if (static_cast<ui_message_handlert *>(message_handler)->get_ui() ==
+          ui_message_handlert::uit::PLAIN)
+        std::cerr << "PARSING ERROR\n";
+
+      return true;
+    }
+
+    auto &lf = language_files.add_file(file.filename);
+    lf.filename = file.filename;
+    lf.language = std::move(file.language);
+    lf.get_modules();
+  }
+
+  return false;
+}
+
 bool ebmc_baset::parse(const std::string &filename) {
 #ifdef _MSC_VER
   std::ifstream infile(widen(filename));
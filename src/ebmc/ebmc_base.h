@@ -20,10 +20,14 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <langapi/language_file.h>
 #include <solvers/prop/prop_conv_solver.h>
 #include <solvers/sat/cnf.h>
+#include <solvers/stack_decision_procedure.h>
 #include <trans-netlist/bmc_map.h>
 #include <trans-netlist/netlist.h>
+#include <trans-netlist/packed_trans_trace.h>
 #include <trans-netlist/trans_trace.h>
 
+#include "resource_limits.h"
+
 class ebmc_baset : public messaget {
 public:
   ebmc_baset(const cmdlinet &_cmdline,
@@ -40,6 +44,11 @@ protected:
   const symbolt *main_symbol;
   optionalt<transt> trans_expr; // transition system expression
 
+  resource_limitst limits;
+  std::string limit_reason; // set when an engine stopped early
+  bool out_of_resources();
+  propt *limited_solver; // told the time left by out_of_resources()
+
   bool get_main();
   bool get_bound();
 
@@ -47,6 +56,11 @@ protected:
   int do_bmc(prop_conv_solvert &solver, bool convert_only);
   int finish_bmc(prop_conv_solvert &solver);
 
+  // word-level, for solvers that are not propositional
+  int do_word_level_bmc(stack_decision_proceduret &solver, bool convert_only);
+  int finish_word_level_bmc(stack_decision_proceduret &solver,
+                            bool convert_only);
+
   // bit-level
   int do_bmc(cnft &solver, bool convert_only);
   int finish_bmc(const bmc_mapt &bmc_map, propt &solver);
@@ -57,6 +71,7 @@ protected:
 
   bool parse();
   bool parse(const std::string &filename);
+  bool parse_parallel(unsigned num_threads);
   bool typecheck();
 
   unsigned bound;
@@ -71,7 +86,10 @@ protected:
     irep_idt mode;
     exprt expr;
     bvt timeframe_literals;
+    exprt::operandst timeframe_handles;
     std::string description;
+    // the deepest bound or frame without a counterexample
+    optionalt<unsigned> bound_reached;
     enum class statust { DISABLED, SUCCESS, FAILURE, UNKNOWN } status;
     
     inline bool is_disabled() const
@@ -104,11 +122,42 @@ protected:
       status=statust::UNKNOWN;
     }
     
-    inline propertyt():number(0), status(statust::UNKNOWN)
+    // see --incremental
+    std::string fingerprint;
+    bool reused;
+
+    // see --json-ui
+    bool streamed;
+
+    // disabled, or the result of an earlier run is used
+    inline bool is_skipped() const
+    {
+      return is_disabled() || reused;
+    }
+
+    inline propertyt():
+      number(0), status(statust::UNKNOWN), reused(false), streamed(false)
     {
     }
     
     trans_tracet counterexample;
+
+    // The bit-level engines record the trace in packed form;
+    // the expressions are then only built for display.
+    packed_trans_tracet packed_counterexample;
+
+    const trans_tracet &get_counterexample(const namespacet &ns)
+    {
+      if(counterexample.states.empty() && !packed_counterexample.empty())
+      {
+        // nothing after the first failing timeframe is ever shown
+        packed_counterexample.materialise(
+          ns, counterexample,
+          packed_counterexample.get_min_failing_timeframe()+1);
+      }
+
+      return counterexample;
+    }
   };
 
   typedef std::list<propertyt> propertiest;
@@ -123,21 +172,40 @@ protected:
   }
   
   void report_results();
+
+  // --json-ui: each event is printed as one JSON object as soon
+  // as it happens; see stream_results.cpp for the schema
+  bool json_ui() const;
+  void stream_result(propertyt &);
+  void stream_bound();
+  void stream_statistics(double solver_time);
+  void push_json(const class json_objectt &);
+
+  // false when an engine builds on the BMC results, which are
+  // then not streamed before they are final
+  bool bmc_results_final;
+
+  // results of earlier runs
+  bool reuse_results();
+  void store_results();
+  bool proof_engine() const;
   
   void show_ldg(std::ostream &out);
   bool make_netlist(netlistt &netlist);  
+  bool make_netlist(netlistt &netlist, bool abstract_memories);
+  void get_memories(std::set<irep_idt> &memories);
 
 public:  
   // solvers
   int do_compute_ct();
   int do_dimacs();
-  //  int do_cvc4();
+  int do_cvc4();
   //  int do_smt1();
-  //  int do_smt2();
-  //  int do_boolector();
-  //  int do_mathsat();
-  //  int do_yices();
-  //  int do_z3();
+  int do_smt2();
+  int do_boolector();
+  int do_mathsat();
+  int do_yices();
+  int do_z3();
   int do_sat();
   int do_prover();
   int do_lifter();
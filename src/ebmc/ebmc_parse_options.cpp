@@ -7,6 +7,13 @@ Author: Daniel Kroening, kroening@kroening.com
 \*******************************************************************/
 
 #include <iostream>
+#include <new>
+#include <sstream>
+
+#ifndef _WIN32
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
 
 #include "ebmc_version.h"
 #include "show_trans.h"
@@ -18,6 +25,7 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <util/config.h>
 #include <util/exit_codes.h>
+#include <util/json.h>
 
 #ifdef HAVE_INTERPOLATION
 #include "interpolation/interpolation_expr.h"
@@ -28,6 +36,10 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "coverage/coverage.h"
 #endif
 
+#ifdef HAVE_VERILOG
+#include <verilog/verilog_preprocessor.h>
+#endif
+
 /*******************************************************************\
 
 Function: ebmc_parse_optionst::doit
@@ -54,6 +66,269 @@ int ebmc_parse_optionst::doit()
     return 0;
   }
 
+  if(cmdline.isset("batch"))
+    return batch();
+
+  return run_job(cmdline);
+}
+
+/*******************************************************************\
+
+Function: ebmc_parse_optionst::batch
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: Reads jobs from stdin, one per line, each given by the
+          command line options of a single run. The languages are
+          registered once. Each job runs in a child process, as
+          the engines may call exit() on errors in the input and
+          keep state in globals. The files given with --preload
+          are read before, and the children start with them.
+          The jobs still parse their sources themselves.
+          A job without source files takes those given with
+          --batch.
+
+\*******************************************************************/
+
+int ebmc_parse_optionst::batch()
+{
+  messaget message(ui_message_handler);
+  std::string line;
+  unsigned job_nr=0;
+
+  // the jobs must not change it for the ones that follow
+  const unsigned verbosity=ui_message_handler.get_verbosity();
+
+  if(ui_message_handler.get_ui()==ui_message_handlert::uit::JSON_UI)
+  {
+    // The children write to the JSON array on their own; it must
+    // have an element before the first one, or the array elements
+    // of the jobs and those of the parent lack a separator.
+    json_objectt json_batch;
+    json_batch["event"]=json_stringt("batch");
+    json_batch["version"]=json_stringt(EBMC_VERSION);
+    ui_message_handler.get_json_stream().push_back(json_batch);
+    std::cout << std::flush;
+  }
+
+  // include files shared by the jobs
+  for(const auto &file_name : cmdline.get_values("preload"))
+  {
+    #ifdef HAVE_VERILOG
+    if(verilog_preprocessort::read_file(file_name)==nullptr)
+    {
+      message.error() << "failed to read `" << file_name << "'"
+                      << messaget::eom;
+      return CPROVER_EXIT_USAGE_ERROR;
+    }
+    #else
+    message.error() << "--preload requires Verilog support"
+                    << messaget::eom;
+    return CPROVER_EXIT_USAGE_ERROR;
+    #endif
+  }
+
+  while(std::getline(std::cin, line))
+  {
+    std::istringstream line_stream(line);
+    std::vector<std::string> args;
+    std::string arg;
+
+    while(line_stream >> arg)
+      args.push_back(arg);
+
+    // empty lines and comments
+    if(args.empty() || args.front()[0]=='#')
+      continue;
+
+    job_nr++;
+
+    std::vector<const char *> argv;
+    argv.push_back("ebmc");
+    for(const auto &a : args)
+      argv.push_back(a.c_str());
+
+    cmdlinet job_cmdline;
+    int result;
+
+    ui_message_handler.set_verbosity(verbosity);
+
+    bool parse_error=
+      job_cmdline.parse(argv.size(), argv.data(), EBMC_OPTIONS);
+
+    // jobs that name no source files check those given with --batch
+    if(!parse_error && job_cmdline.args.empty())
+      job_cmdline.args=cmdline.args;
+
+    if(parse_error || config.set(job_cmdline))
+    {
+      message.error() << "job " << job_nr << ": invalid options"
+                      << messaget::eom;
+      result=CPROVER_EXIT_USAGE_ERROR;
+    }
+    else if(job_cmdline.isset("batch") ||
+            job_cmdline.isset("preload") ||
+            job_cmdline.isset("xml-ui") ||
+            job_cmdline.isset("json-ui") ||
+            job_cmdline.isset("gui"))
+    {
+      // the output format is that of the whole batch
+      message.error() << "job " << job_nr << ": --batch, --preload, "
+                      << "--xml-ui, --json-ui and --gui are not allowed "
+                      << "in a job"
+                      << messaget::eom;
+      result=CPROVER_EXIT_USAGE_ERROR;
+    }
+    else
+      result=run_child_job(job_cmdline);
+
+    if(ui_message_handler.get_ui()==ui_message_handlert::uit::JSON_UI)
+    {
+      json_objectt json_job;
+      json_job["event"]=json_stringt("job");
+      json_job["job"]=json_numbert(std::to_string(job_nr));
+      json_job["result"]=json_numbert(std::to_string(result));
+      ui_message_handler.get_json_stream().push_back(json_job);
+      std::cout << std::flush;
+    }
+    else
+      message.status() << "** Job " << job_nr << " done with exit code "
+                       << result << messaget::eom;
+  }
+
+  return 0;
+}
+
+/*******************************************************************\
+
+Function: ebmc_parse_optionst::run_child_job
+
+  Inputs:
+
+ Outputs: the exit code of the job
+
+ Purpose: runs a job of --batch in a child process
+
+\*******************************************************************/
+
+int ebmc_parse_optionst::run_child_job(const cmdlinet &job_cmdline)
+{
+  #ifdef _WIN32
+  return run_job_safely(job_cmdline);
+  #else
+  // or the child prints it once more
+  std::cout << std::flush;
+  std::cerr << std::flush;
+
+  pid_t pid=fork();
+
+  if(pid<0)
+  {
+    messaget(ui_message_handler).error() << "failed to fork" << messaget::eom;
+    return CPROVER_EXIT_INTERNAL_ERROR;
+  }
+
+  if(pid==0)
+  {
+    int result=run_job_safely(job_cmdline);
+    std::cout << std::flush;
+    std::cerr << std::flush;
+
+    // the parent closes the output of the message handler
+    _exit(result);
+  }
+
+  int status;
+
+  if(waitpid(pid, &status, 0)<0)
+    return CPROVER_EXIT_INTERNAL_ERROR;
+
+  if(WIFEXITED(status))
+    return WEXITSTATUS(status);
+
+  messaget(ui_message_handler).error()
+    << "job killed by signal " << WTERMSIG(status) << messaget::eom;
+  return CPROVER_EXIT_INTERNAL_ERROR;
+  #endif
+}
+
+/*******************************************************************\
+
+Function: ebmc_parse_optionst::run_job_safely
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: a job that throws must not end the batch
+
+\*******************************************************************/
+
+int ebmc_parse_optionst::run_job_safely(const cmdlinet &job_cmdline)
+{
+  messaget message(ui_message_handler);
+
+  try
+  {
+    return run_job(job_cmdline);
+  }
+
+  catch(const char *e)
+  {
+    message.error() << e << messaget::eom;
+  }
+
+  catch(const std::string &e)
+  {
+    message.error() << e << messaget::eom;
+  }
+
+  catch(const std::bad_alloc &)
+  {
+    message.error() << "Out of memory" << messaget::eom;
+    return CPROVER_EXIT_INTERNAL_OUT_OF_MEMORY;
+  }
+
+  catch(int)
+  {
+  }
+
+  catch(...)
+  {
+    message.error() << "unexpected exception" << messaget::eom;
+  }
+
+  return CPROVER_EXIT_EXCEPTION;
+}
+
+/*******************************************************************\
+
+Function: ebmc_parse_optionst::run_job
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: one run, for the options given on the command line
+          or in a line of --batch
+
+\*******************************************************************/
+
+int ebmc_parse_optionst::run_job(const cmdlinet &cmdline)
+{
+  {
+    std::string option;
+
+    if(resource_limitst::check_options(cmdline, option))
+    {
+      messaget(ui_message_handler).error()
+        << "--" << option << " expects a number" << messaget::eom;
+      return CPROVER_EXIT_USAGE_ERROR;
+    }
+  }
+
   if(cmdline.isset("diatest"))
   {
     std::cout << "This option is currently disabled\n";
@@ -200,7 +475,6 @@ int ebmc_parse_optionst::doit()
 
     if(cmdline.isset("dimacs"))
       return ebmc_base.do_dimacs();
-    /*
     else if(cmdline.isset("cvc4"))
       return ebmc_base.do_cvc4();
     else if(cmdline.isset("boolector"))
@@ -213,7 +487,6 @@ int ebmc_parse_optionst::doit()
       return ebmc_base.do_yices();
     else if(cmdline.isset("smt2"))
       return ebmc_base.do_smt2();
-    */
     else if(cmdline.isset("prover"))
       return ebmc_base.do_prover();
     else if(cmdline.isset("lifter"))
@@ -253,16 +526,40 @@ void ebmc_parse_optionst::help()
     "\n"
     "Additonal options:\n"
     " --bound <nr>                      set bound (default: 1)\n"
-    // " --max-bound <nr>                  set maximum bound\n"
+    " --max-bound <nr>                  with the SMT solvers, check with the bounds\n"
+    "                                   1 to <nr> in turn instead of --bound, until\n"
+    "                                   all properties fail; --incremental then\n"
+    "                                   compares with <nr>\n"
     " --module <module>                 set top module (deprecated)\n"
     " --top <module>                    set top module\n"
     " -p <expr>                         specify a property\n"
     " --outfile <file name>             set output file name (default: stdout)\n"
     " --trace                           generate a trace for failing properties\n"
     " --vcd <file name>                 generate traces in VCD format\n"
+    " --json-ui                         print each result as a JSON object as\n"
+    "                                   soon as it is known\n"
+    " --batch                           read jobs from stdin, one line of\n"
+    "                                   options each, and run each in a child\n"
+    "                                   process; the jobs parse their sources\n"
+    "                                   themselves; jobs without source files\n"
+    "                                   check those given with --batch\n"
+    " --preload <file>                  with --batch, read the include file once\n"
+    "                                   for all jobs, under the path that the\n"
+    "                                   jobs use, e.g., <dir>/<file> with -I <dir>\n"
     " --show-properties                 list the properties in the model\n"
     " --property <id>                   check the property with given ID\n"
     " -I path                           set include path\n"
+    " --num-threads <nr>                preprocess the source files in <nr> threads\n"
+    "                                   (with --ic3, run <nr> IC3 workers)\n"
+    " --incremental <file>              reuse the results for properties whose\n"
+    "                                   cone of influence is unchanged\n"
+    " --time-limit <s>                  stop the engine after <s> seconds; the\n"
+    "                                   SMT solvers are only stopped between\n"
+    "                                   properties\n"
+    " --cpu-limit <s>                   stop the engine after <s> CPU seconds\n"
+    " --memory-limit <MB>               stop the engine when it uses <MB> MB\n"
+    " --conflict-limit <nr>             stop IC3 after <nr> SAT conflicts\n"
+    " --bdd-node-limit <nr>             stop the BDD engine at <nr> nodes\n"
     " --reset <expr>                    set up module reset\n"
     "\n"
     "Methods:\n"
@@ -274,6 +571,11 @@ void ebmc_parse_optionst::help()
     "       --h                              print out help information\n"
     "       --new-mode                       new mode is switched on\n"
     "       --aiger                          print out the instance in aiger format\n"
+    "       --inv-cache <dir>                store the invariant in <dir>, reuse it in later runs\n"
+    "       --via-circuit                    generate the CNFs via an intermediate circuit\n"
+    "       --ternary-lift                   lift states by ternary simulation\n"
+    "       --bmc-hybrid                     run BMC up to --bound before IC3 and,\n"
+    "                                        if IC3 is undecided, with its clauses\n"
     
     //" --interpolation                   use bit-level interpolants\n"
     //" --interpolation-word              use word-level interpolants\n"
@@ -281,6 +583,7 @@ void ebmc_parse_optionst::help()
     "\n"
     "Solvers:\n"
     " --aig                             bit-level SAT with AIGs\n"
+    " --memory-abstraction              do not bit-blast memories (BMC only)\n"
     " --dimacs                          output bit-level CNF in DIMACS format\n"
     " --smt1                            output word-level SMT 1 formula\n"
     " --smt2                            output word-level SMT 2 formula\n"
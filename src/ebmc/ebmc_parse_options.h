@@ -14,6 +14,27 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "ebmc_version.h"
 
+#define EBMC_OPTIONS \
+  "(diameter)(ediameter)" \
+  "(diatest)(statebits):(bound):(max-bound):" \
+  "(show-parse)(show-varmap)(show-symbol-table)(show-netlist)" \
+  "(show-ldg)(show-modules)(show-trans)(show-bdds)" \
+  "(show-properties)(property):p:(trace)" \
+  "(dimacs)(module):(top):" \
+  "(po)(cegar)(k-induction)(2pi)(bound2):" \
+  "(outfile):(xml-ui)(json-ui)(verbosity):(gui)" \
+  "(reset):" \
+  "(version)(verilog-rtl)(verilog-netlist)" \
+  "(compute-interpolant)(interpolation)(interpolation-vmcai)" \
+  "(ic3)(property):(constr)(h)(new-mode)(aiger)(inv-cache):(via-circuit)(ternary-lift)(bmc-hybrid)" \
+  "(interpolation-word)(interpolator):(bdd)" \
+  "(smt1)(smt2)(boolector)(z3)(cvc4)(yices)(mathsat)(prover)(lifter)" \
+  "(aig)(stop-induction)(stop-minimize)(start):(coverage)(naive)" \
+  "(compute-ct)(dot-netlist)(smv-netlist)(vcd):I:" \
+  "(memory-abstraction)(num-threads):(incremental):" \
+  "(time-limit):(cpu-limit):(memory-limit):(conflict-limit):" \
+  "(bdd-node-limit):(batch)(preload):"
+
 class ebmc_parse_optionst:public parse_options_baset
 {
 public:
@@ -22,22 +43,7 @@ public:
 
   ebmc_parse_optionst(int argc, const char **argv)
       : parse_options_baset(
-            "(diameter)(ediameter)"
-            "(diatest)(statebits):(bound):(max-bound):"
-            "(show-parse)(show-varmap)(show-symbol-table)(show-netlist)"
-            "(show-ldg)(show-modules)(show-trans)(show-bdds)"
-            "(show-properties)(property):p:(trace)"
-            "(dimacs)(module):(top):"
-            "(po)(cegar)(k-induction)(2pi)(bound2):"
-            "(outfile):(xml-ui)(verbosity):(gui)"
-            "(reset):"
-            "(version)(verilog-rtl)(verilog-netlist)"
-            "(compute-interpolant)(interpolation)(interpolation-vmcai)"
-            "(ic3)(property):(constr)(h)(new-mode)(aiger)"
-            "(interpolation-word)(interpolator):(bdd)"
-            "(smt1)(smt2)(boolector)(z3)(cvc4)(yices)(mathsat)(prover)(lifter)"
-            "(aig)(stop-induction)(stop-minimize)(start):(coverage)(naive)"
-            "(compute-ct)(dot-netlist)(smv-netlist)(vcd):I:",
+            EBMC_OPTIONS,
             argc, argv, std::string("EBMC ") + EBMC_VERSION),
         ui_message_handler(cmdline, "EBMC " EBMC_VERSION) {}
 
@@ -45,6 +51,12 @@ public:
   
 protected:
   void register_languages();
+
+  // --batch
+  int batch();
+  int run_child_job(const cmdlinet &);
+  int run_job_safely(const cmdlinet &);
+  int run_job(const cmdlinet &);
   
   ui_message_handlert ui_message_handler;
 };
@@ -14,7 +14,8 @@ Author: Daniel Kroening, kroening@kroening.com
 //#include <solvers/cvc/cvc_dec.h>
 //#include <solvers/dplib/dplib_dec.h>
 //#include <solvers/smt1/smt1_dec.h>
-//#include <solvers/smt2/smt2_dec.h>
+#include <solvers/smt2/smt2_conv.h>
+#include <solvers/smt2/smt2_dec.h>
 #include <solvers/flattening/boolbv.h>
 #include <solvers/sat/dimacs_cnf.h>
 #include <solvers/sat/satcheck.h>
@@ -81,7 +82,6 @@ Function: ebmc_baset::do_smt2
  Purpose:
 
 \*******************************************************************/
-/*
 int ebmc_baset::do_smt2()
 {
   const namespacet ns(symbol_table);
@@ -93,9 +93,9 @@ int ebmc_baset::do_smt2()
 
     if(!out)
     {
-      std::cerr << "Failed to open `"
-                << filename
-                << "'" << '\n';
+      error() << "Failed to open `"
+              << filename
+              << "'" << messaget::eom;
       return 1;
     }
 
@@ -107,7 +107,7 @@ int ebmc_baset::do_smt2()
       smt2_convt::solvert::Z3,
       out);
 
-    return do_bmc(smt2_conv, true);
+    return do_word_level_bmc(smt2_conv, true);
   }
 
   smt2_convt smt2_conv(
@@ -118,9 +118,9 @@ int ebmc_baset::do_smt2()
     smt2_convt::solvert::Z3,
     std::cout);
 
-  return do_bmc(smt2_conv, true);
+  return do_word_level_bmc(smt2_conv, true);
 }
-*/
+
 /*******************************************************************\
 
 Function: ebmc_baset::do_mathsat
@@ -132,7 +132,6 @@ Function: ebmc_baset::do_mathsat
  Purpose:
 
 \*******************************************************************/
-/*
 int ebmc_baset::do_mathsat()
 {
   const namespacet ns(symbol_table);
@@ -142,11 +141,12 @@ int ebmc_baset::do_mathsat()
     "ebmc",
     "Generated by EBMC " EBMC_VERSION,
     "QF_AUFBV",
-    smt2_dect::solvert::MATHSAT);
+    smt2_dect::solvert::MATHSAT,
+    *message_handler);
 
-  return do_bmc(smt2_dec, false);
+  return do_word_level_bmc(smt2_dec, false);
 }
-*/
+
 /*******************************************************************\
 
 Function: ebmc_baset::do_z3
@@ -158,7 +158,6 @@ Function: ebmc_baset::do_z3
  Purpose:
 
 \*******************************************************************/
-/*
 int ebmc_baset::do_z3()
 {
   const namespacet ns(symbol_table);
@@ -168,11 +167,12 @@ int ebmc_baset::do_z3()
     "ebmc",
     "Generated by EBMC " EBMC_VERSION,
     "QF_AUFBV",
-    smt2_dect::solvert::Z3);
+    smt2_dect::solvert::Z3,
+    *message_handler);
 
-  return do_bmc(smt2_dec, false);
+  return do_word_level_bmc(smt2_dec, false);
 }
-*/
+
 /*******************************************************************\
 
 Function: ebmc_baset::do_cvc4
@@ -184,7 +184,6 @@ Function: ebmc_baset::do_cvc4
  Purpose:
 
 \*******************************************************************/
-/*
 int ebmc_baset::do_cvc4()
 {
   const namespacet ns(symbol_table);
@@ -194,11 +193,12 @@ int ebmc_baset::do_cvc4()
     "ebmc",
     "Generated by EBMC " EBMC_VERSION,
     "QF_AUFBV",
-    smt2_dect::solvert::CVC4);
+    smt2_dect::solvert::CVC4,
+    *message_handler);
 
-  return do_bmc(smt2_dec, false);
+  return do_word_level_bmc(smt2_dec, false);
 }
-*/
+
 /*******************************************************************\
 
 Function: ebmc_baset::do_yices
@@ -210,7 +210,6 @@ Function: ebmc_baset::do_yices
  Purpose:
 
 \*******************************************************************/
-/*
 int ebmc_baset::do_yices()
 {
   const namespacet ns(symbol_table);
@@ -220,11 +219,12 @@ int ebmc_baset::do_yices()
     "ebmc",
     "Generated by EBMC " EBMC_VERSION,
     "QF_AUFBV",
-    smt2_dect::solvert::YICES);
+    smt2_dect::solvert::YICES,
+    *message_handler);
 
-  return do_bmc(smt2_dec, false);
+  return do_word_level_bmc(smt2_dec, false);
 }
-*/
+
 /*******************************************************************\
 
 Function: ebmc_baset::do_boolector
@@ -236,7 +236,6 @@ Function: ebmc_baset::do_boolector
  Purpose:
 
 \*******************************************************************/
-/*
 int ebmc_baset::do_boolector()
 {
   const namespacet ns(symbol_table);
@@ -246,11 +245,12 @@ int ebmc_baset::do_boolector()
     "ebmc",
     "Generated by EBMC " EBMC_VERSION,
     "QF_AUFBV",
-    smt2_dect::solvert::BOOLECTOR);
+    smt2_dect::solvert::BOOLECTOR,
+    *message_handler);
 
-  return do_bmc(smt2_dec, false);
+  return do_word_level_bmc(smt2_dec, false);
 }
-*/
+
 /*******************************************************************\
 
 Function: ebmc_baset::do_sat
@@ -266,19 +266,33 @@ Function: ebmc_baset::do_sat
 int ebmc_baset::do_sat()
 {
   satcheckt satcheck{*message_handler};
+  limits.limit_solver(satcheck);
+  limited_solver=&satcheck;
 
   status() << "Using " << satcheck.solver_text() << eom;
 
+  int result;
+
   if(cmdline.isset("aig"))
   {
-    return do_bmc(satcheck, false);
+    result=do_bmc(satcheck, false);
   }
   else
   {
     const namespacet ns(symbol_table);
     boolbvt boolbv(ns, satcheck, *message_handler);
-    return do_bmc(boolbv, false);
+
+    // arrays are then encoded with constraints
+    // per access instead of being flattened
+    if(cmdline.isset("memory-abstraction"))
+      boolbv.unbounded_array=boolbvt::unbounded_arrayt::U_ALL;
+
+    result=do_bmc(boolbv, false);
   }
+
+  limited_solver=nullptr;
+
+  return result;
 }
 
 /*******************************************************************\
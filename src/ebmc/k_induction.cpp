@@ -30,7 +30,11 @@ class k_inductiont:public ebmc_baset
 public:
   k_inductiont(const cmdlinet &_cmdline,
                ui_message_handlert &_ui_message_handler)
-      : ebmc_baset(_cmdline, _ui_message_handler), ns{symbol_table} {}
+      : ebmc_baset(_cmdline, _ui_message_handler), ns{symbol_table}
+  {
+    // the induction step decides what the base case did not refute
+    bmc_results_final=false;
+  }
 
   int operator()();
 
@@ -114,6 +118,7 @@ int k_inductiont::induction_base()
   status() << "Induction Base" << eom;
 
   satcheckt satcheck{*message_handler};
+  limits.limit_solver(satcheck);
   boolbvt solver(ns, satcheck, *message_handler);
 
   ::unwind(*trans_expr, *message_handler, solver, bound + 1, ns, true);
@@ -147,11 +152,19 @@ int k_inductiont::induction_step()
 
   for(auto &p_it : properties)
   {
-    if(p_it.is_disabled() ||
+    if(p_it.is_skipped() ||
        p_it.is_failure())
       continue;
 
+    // the base case alone does not prove the property
+    if(out_of_resources())
+    {
+      p_it.make_unknown();
+      continue;
+    }
+
     satcheckt satcheck{*message_handler};
+    limits.limit_solver(satcheck);
     boolbvt solver(ns, satcheck, *message_handler);
 
     // *no* initial state
@@ -201,6 +214,12 @@ int k_inductiont::induction_step()
       break;
 
     case decision_proceduret::resultt::D_ERROR:
+      // the solver was interrupted
+      if(out_of_resources())
+      {
+        p_it.make_unknown();
+        break;
+      }
       error() << "Error from decision procedure" << eom;
       return 2;
 
@@ -208,6 +227,8 @@ int k_inductiont::induction_step()
       error() << "Unexpected result from decision procedure" << eom;
       return 1;
     }
+
+    stream_result(p_it);
   }
 
   // We return '0' if the property holds,
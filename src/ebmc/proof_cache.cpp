@@ -0,0 +1,511 @@
+/*******************************************************************\
+
+Module: Results of Earlier Runs
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <unordered_map>
+#include <vector>
+
+#include "proof_cache.h"
+
+/*******************************************************************\
+
+Function: proof_cachet::read
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+bool proof_cachet::read(const std::string &file_name)
+{
+  std::ifstream in(file_name);
+
+  // nothing cached yet
+  if(!in)
+    return false;
+
+  std::string line;
+
+  while(std::getline(in, line))
+  {
+    std::istringstream line_stream(line);
+    std::string fingerprint, kind;
+
+    if(!(line_stream >> fingerprint >> kind))
+      continue;
+
+    if(kind=="proved")
+      proved(fingerprint);
+    else if(kind=="bounded")
+    {
+      unsigned bound;
+      if(!(line_stream >> bound))
+        return true;
+      bounded(fingerprint, bound);
+    }
+    else
+      return true;
+  }
+
+  return false;
+}
+
+/*******************************************************************\
+
+Function: proof_cachet::write
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+bool proof_cachet::write(const std::string &file_name) const
+{
+  std::ofstream out(file_name);
+
+  if(!out)
+    return true;
+
+  for(const auto &entry : entries)
+  {
+    out << entry.first;
+
+    if(entry.second.proved)
+      out << " proved\n";
+    else
+      out << " bounded " << entry.second.bound << '\n';
+  }
+
+  return !out;
+}
+
+/*******************************************************************\
+
+Function: proof_cachet::bounded
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void proof_cachet::bounded(const std::string &fingerprint, unsigned bound)
+{
+  entryt &entry=entries[fingerprint];
+
+  if(!entry.proved && bound>entry.bound)
+    entry.bound=bound;
+}
+
+/*******************************************************************\
+
+   Class: stable_hasht
+
+ Purpose: FNV-1a over the strings of an irep, ignoring comments.
+          The named subtrees are taken in the order of their
+          names, not in the order of the string table.
+
+\*******************************************************************/
+
+class stable_hasht
+{
+public:
+  typedef std::uint64_t hasht;
+
+  static void add(hasht &h, const std::string &s)
+  {
+    for(const char ch : s)
+    {
+      h^=static_cast<unsigned char>(ch);
+      h*=prime;
+    }
+
+    // separator
+    h^=0xff;
+    h*=prime;
+  }
+
+  static void add(hasht &h, hasht value)
+  {
+    for(unsigned i=0; i<8; i++)
+    {
+      h^=(value>>(i*8))&0xff;
+      h*=prime;
+    }
+  }
+
+  hasht operator()(const irept &irep)
+  {
+    // shared subtrees are done once
+    auto c_it=cache.find(&irep.read());
+    if(c_it!=cache.end())
+      return c_it->second;
+
+    hasht h=basis;
+    add(h, irep.id_string());
+
+    std::vector<std::pair<std::string, const irept *> > named;
+
+    for(const auto &n : irep.get_named_sub())
+      if(!irept::is_comment(n.first))
+        named.emplace_back(id2string(n.first), &n.second);
+
+    std::sort(named.begin(), named.end());
+
+    for(const auto &n : named)
+    {
+      add(h, n.first);
+      add(h, (*this)(*n.second));
+    }
+
+    for(const auto &s : irep.get_sub())
+      add(h, (*this)(s));
+
+    cache[&irep.read()]=h;
+
+    return h;
+  }
+
+  static const hasht basis=14695981039346656037ull;
+  static const hasht prime=1099511628211ull;
+
+protected:
+  std::unordered_map<const void *, hasht> cache;
+};
+
+/*******************************************************************\
+
+Function: get_conjuncts
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+static void get_conjuncts(const exprt &expr, std::vector<exprt> &dest)
+{
+  if(expr.id()==ID_and)
+  {
+    for(const auto &op : expr.operands())
+      get_conjuncts(op, dest);
+  }
+  else if(!expr.is_true())
+    dest.push_back(expr);
+}
+
+/*******************************************************************\
+
+Function: get_identifiers
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: the symbols in the expression, current or next state
+
+\*******************************************************************/
+
+static void get_identifiers(
+  const exprt &expr,
+  std::set<irep_idt> &dest,
+  std::set<const void *> &visited)
+{
+  if(!visited.insert(&expr.read()).second)
+    return;
+
+  if(expr.id()==ID_symbol || expr.id()==ID_next_symbol)
+    dest.insert(expr.get(ID_identifier));
+
+  for(const auto &op : expr.operands())
+    get_identifiers(op, dest, visited);
+}
+
+/*******************************************************************\
+
+Function: get_definition_key
+
+  Inputs:
+
+ Outputs: false if the conjunct is not of the form 'x=e' or
+          'next(x)=e'
+
+ Purpose:
+
+\*******************************************************************/
+
+typedef std::pair<bool, irep_idt> definition_keyt;
+
+static bool get_definition_key(const exprt &expr, definition_keyt &key)
+{
+  if(expr.id()!=ID_equal)
+    return false;
+
+  const exprt &lhs=to_equal_expr(expr).lhs();
+
+  if(lhs.id()!=ID_symbol && lhs.id()!=ID_next_symbol)
+    return false;
+
+  key=definition_keyt(lhs.id()==ID_next_symbol, lhs.get(ID_identifier));
+
+  return true;
+}
+
+/*******************************************************************\
+
+Function: get_definition_keys
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: the values of x and next(x) that the right-hand side
+          of a definition refers to
+
+\*******************************************************************/
+
+static void get_definition_keys(
+  const exprt &expr,
+  std::set<definition_keyt> &dest)
+{
+  if(expr.id()==ID_symbol || expr.id()==ID_next_symbol)
+    dest.insert(definition_keyt(
+      expr.id()==ID_next_symbol, expr.get(ID_identifier)));
+
+  for(const auto &op : expr.operands())
+    get_definition_keys(op, dest);
+}
+
+/*******************************************************************\
+
+Function: proof_cachet::fingerprint
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: A conjunct 'x=e' or 'next(x)=e' defines x if it is the
+          only one that constrains that value of x in any of the
+          parts of the transition system, and if e does not depend
+          on it, directly or through other definitions. It is then
+          in the cone if x is. Any other conjunct may constrain the
+          paths, and is always taken.
+
+\*******************************************************************/
+
+std::string proof_cachet::fingerprint(
+  const transt &trans,
+  const exprt &property)
+{
+  struct conjunctt
+  {
+    std::string part;
+    exprt expr;
+    std::set<irep_idt> identifiers;
+    irep_idt defines;
+    bool in_cone;
+  };
+
+  std::vector<conjunctt> conjuncts;
+
+  const std::pair<std::string, const exprt *> parts[]=
+  {
+    { "invar", &trans.invar() },
+    { "init", &trans.init() },
+    { "trans", &trans.trans() }
+  };
+
+  for(const auto &part : parts)
+  {
+    std::vector<exprt> exprs;
+    get_conjuncts(*part.second, exprs);
+
+    for(auto &expr : exprs)
+    {
+      conjuncts.push_back(conjunctt());
+      conjunctt &conjunct=conjuncts.back();
+      conjunct.part=part.first;
+      conjunct.in_cone=false;
+
+      std::set<const void *> visited;
+      get_identifiers(expr, conjunct.identifiers, visited);
+
+      conjunct.expr.swap(expr);
+    }
+  }
+
+  // How often is each value defined, over all parts. 'x=e' in
+  // the invariant or the transition relation constrains x in
+  // every state, and hence also next(x); only 'x=e' in the
+  // initial states and 'next(x)=e' may go together.
+  std::map<definition_keyt, unsigned> definitions;
+
+  for(const auto &conjunct : conjuncts)
+  {
+    definition_keyt key;
+
+    if(!get_definition_key(conjunct.expr, key))
+      continue;
+
+    definitions[key]++;
+
+    if(!key.first && conjunct.part!="init")
+      definitions[definition_keyt(true, key.second)]++;
+  }
+
+  // value -> the conjunct that is its only definition
+  std::map<definition_keyt, std::size_t> definers;
+
+  for(std::size_t i=0; i<conjuncts.size(); i++)
+  {
+    definition_keyt key;
+
+    if(get_definition_key(conjuncts[i].expr, key) &&
+       definitions[key]==1 &&
+       (key.first || conjuncts[i].part=="init" ||
+        definitions[definition_keyt(true, key.second)]==1))
+      definers[key]=i;
+  }
+
+  // Definitions that depend on themselves, such as 'x=x+1' or a
+  // combinational loop, constrain the paths. Take the ones whose
+  // right-hand sides only depend on definitions taken before.
+  {
+    std::map<definition_keyt, unsigned> pending;
+    std::map<definition_keyt, std::vector<definition_keyt> > users;
+    std::vector<definition_keyt> ready;
+
+    for(const auto &d : definers)
+    {
+      std::set<definition_keyt> keys;
+      get_definition_keys(to_equal_expr(conjuncts[d.second].expr).rhs(), keys);
+
+      unsigned &count=pending[d.first];
+      count=0;
+
+      for(const auto &key : keys)
+        if(definers.find(key)!=definers.end())
+        {
+          count++;
+          users[key].push_back(d.first);
+        }
+
+      if(count==0)
+        ready.push_back(d.first);
+    }
+
+    while(!ready.empty())
+    {
+      definition_keyt key=ready.back();
+      ready.pop_back();
+
+      conjuncts[definers[key]].defines=key.second;
+
+      for(const auto &user : users[key])
+        if(--pending[user]==0)
+          ready.push_back(user);
+    }
+  }
+
+  // symbol -> conjuncts that define it
+  std::map<irep_idt, std::vector<std::size_t> > defined_by;
+
+  for(std::size_t i=0; i<conjuncts.size(); i++)
+    if(!conjuncts[i].defines.empty())
+      defined_by[conjuncts[i].defines].push_back(i);
+
+  // now compute the cone
+  std::set<irep_idt> cone;
+  std::vector<irep_idt> queue;
+
+  {
+    std::set<irep_idt> identifiers;
+    std::set<const void *> visited;
+    get_identifiers(property, identifiers, visited);
+
+    for(const auto &conjunct : conjuncts)
+      if(conjunct.defines.empty())
+        identifiers.insert(
+          conjunct.identifiers.begin(), conjunct.identifiers.end());
+
+    for(const auto &identifier : identifiers)
+      if(cone.insert(identifier).second)
+        queue.push_back(identifier);
+  }
+
+  for(auto &conjunct : conjuncts)
+    if(conjunct.defines.empty())
+      conjunct.in_cone=true;
+
+  while(!queue.empty())
+  {
+    irep_idt identifier=queue.back();
+    queue.pop_back();
+
+    auto d_it=defined_by.find(identifier);
+    if(d_it==defined_by.end())
+      continue;
+
+    for(const auto i : d_it->second)
+    {
+      conjunctt &conjunct=conjuncts[i];
+
+      if(conjunct.in_cone)
+        continue;
+
+      conjunct.in_cone=true;
+
+      for(const auto &id : conjunct.identifiers)
+        if(cone.insert(id).second)
+          queue.push_back(id);
+    }
+  }
+
+  // the order of the conjuncts does not matter
+  stable_hasht stable_hash;
+  std::vector<stable_hasht::hasht> hashes;
+
+  for(const auto &conjunct : conjuncts)
+    if(conjunct.in_cone)
+    {
+      stable_hasht::hasht h=stable_hasht::basis;
+      stable_hasht::add(h, conjunct.part);
+      stable_hasht::add(h, stable_hash(conjunct.expr));
+      hashes.push_back(h);
+    }
+
+  std::sort(hashes.begin(), hashes.end());
+
+  stable_hasht::hasht h=stable_hasht::basis;
+  stable_hasht::add(h, stable_hash(property));
+
+  for(const auto conjunct_hash : hashes)
+    stable_hasht::add(h, conjunct_hash);
+
+  std::ostringstream result;
+  result << std::hex;
+  result.width(16);
+  result.fill('0');
+  result << h;
+
+  return result.str();
+}
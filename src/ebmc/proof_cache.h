@@ -0,0 +1,64 @@
+/*******************************************************************\
+
+Module: Results of Earlier Runs
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+#ifndef CPROVER_EBMC_PROOF_CACHE_H
+#define CPROVER_EBMC_PROOF_CACHE_H
+
+#include <map>
+#include <string>
+
+#include <util/mathematical_expr.h>
+
+// A property is identified by a fingerprint of the property
+// and of the part of the transition system that is in its
+// cone of influence. Edits outside of the cone do not change
+// the fingerprint, and the result of an earlier run can be
+// used again.
+
+class proof_cachet
+{
+public:
+  struct entryt
+  {
+    // proven by an unbounded engine; otherwise,
+    // there is no counterexample up to 'bound'
+    bool proved;
+    unsigned bound;
+
+    entryt():proved(false), bound(0)
+    {
+    }
+  };
+
+  typedef std::map<std::string, entryt> entriest;
+  entriest entries;
+
+  // returns true on error; a missing file is not an error
+  bool read(const std::string &file_name);
+  bool write(const std::string &file_name) const;
+
+  const entryt *find(const std::string &fingerprint) const
+  {
+    entriest::const_iterator it=entries.find(fingerprint);
+    return it==entries.end()?nullptr:&it->second;
+  }
+
+  void proved(const std::string &fingerprint)
+  {
+    entries[fingerprint].proved=true;
+  }
+
+  void bounded(const std::string &fingerprint, unsigned bound);
+
+  // Unlike irept::hash(), this is stable across runs.
+  static std::string fingerprint(
+    const transt &trans,
+    const exprt &property);
+};
+
+#endif
@@ -0,0 +1,330 @@
+/*******************************************************************\
+
+Module: Resource Limits of the Engines
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+#include <util/string2int.h>
+
+#include <solvers/prop/prop.h>
+
+#include "resource_limits.h"
+
+/*******************************************************************\
+
+Function: parse_seconds
+
+  Inputs:
+
+ Outputs: true if the string is not a number of seconds
+
+ Purpose:
+
+\*******************************************************************/
+
+static bool parse_seconds(const std::string &src, double &dest)
+{
+  if(src.empty())
+    return true;
+
+  char *end;
+  double value=std::strtod(src.c_str(), &end);
+
+  if(*end!=0 || !std::isfinite(value) || value<0)
+    return true;
+
+  dest=value;
+  return false;
+}
+
+/*******************************************************************\
+
+Function: is_number
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+static bool is_number(const std::string &src)
+{
+  if(src.empty())
+    return false;
+
+  for(const char ch : src)
+    if(!isdigit(ch))
+      return false;
+
+  return true;
+}
+
+/*******************************************************************\
+
+Function: resource_limitst::check_options
+
+  Inputs:
+
+ Outputs: true if the argument of one of the options is not a
+          number; the option is then given in 'option'
+
+ Purpose:
+
+\*******************************************************************/
+
+bool resource_limitst::check_options(
+  const cmdlinet &cmdline,
+  std::string &option)
+{
+  double seconds;
+
+  for(const char *o : { "time-limit", "cpu-limit" })
+    if(cmdline.isset(o) && parse_seconds(cmdline.get_value(o), seconds))
+    {
+      option=o;
+      return true;
+    }
+
+  for(const char *o : { "memory-limit", "conflict-limit", "bdd-node-limit" })
+    if(cmdline.isset(o) && !is_number(cmdline.get_value(o)))
+    {
+      option=o;
+      return true;
+    }
+
+  return false;
+}
+
+/*******************************************************************\
+
+Function: resource_limitst::resource_limitst
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+resource_limitst::resource_limitst(const cmdlinet &cmdline):
+  wall_time_limit(0),
+  cpu_time_limit(0),
+  memory_limit(0),
+  conflict_limit(0),
+  bdd_node_limit(0),
+  start_time(std::chrono::steady_clock::now())
+{
+  // check_options() has rejected anything else
+  if(cmdline.isset("time-limit"))
+    parse_seconds(cmdline.get_value("time-limit"), wall_time_limit);
+
+  if(cmdline.isset("cpu-limit"))
+    parse_seconds(cmdline.get_value("cpu-limit"), cpu_time_limit);
+
+  if(cmdline.isset("memory-limit"))
+    memory_limit=unsafe_string2size_t(cmdline.get_value("memory-limit"));
+
+  if(cmdline.isset("conflict-limit"))
+    conflict_limit=
+      unsafe_string2unsignedlonglong(cmdline.get_value("conflict-limit"));
+
+  if(cmdline.isset("bdd-node-limit"))
+    bdd_node_limit=unsafe_string2size_t(cmdline.get_value("bdd-node-limit"));
+}
+
+/*******************************************************************\
+
+Function: resource_limitst::exhausted
+
+  Inputs:
+
+ Outputs: true if the time or the memory is used up
+
+ Purpose:
+
+\*******************************************************************/
+
+bool resource_limitst::exhausted(std::string &reason) const
+{
+  if(wall_time_limit>0 && wall_time()>=wall_time_limit)
+  {
+    reason="time limit";
+    return true;
+  }
+
+  if(cpu_time_limit>0 && cpu_time()>=cpu_time_limit)
+  {
+    reason="CPU time limit";
+    return true;
+  }
+
+  if(memory_limit>0 && resident_memory()>=memory_limit)
+  {
+    reason="memory limit";
+    return true;
+  }
+
+  return false;
+}
+
+/*******************************************************************\
+
+Function: resource_limitst::conflicts_exhausted
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+bool resource_limitst::conflicts_exhausted(
+  unsigned long long conflicts,
+  std::string &reason) const
+{
+  if(conflict_limit>0 && conflicts>=conflict_limit)
+  {
+    reason="conflict limit";
+    return true;
+  }
+
+  return false;
+}
+
+/*******************************************************************\
+
+Function: resource_limitst::bdd_nodes_exhausted
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+bool resource_limitst::bdd_nodes_exhausted(
+  std::size_t nodes,
+  std::string &reason) const
+{
+  if(bdd_node_limit>0 && nodes>=bdd_node_limit)
+  {
+    reason="BDD node limit";
+    return true;
+  }
+
+  return false;
+}
+
+/*******************************************************************\
+
+Function: resource_limitst::limit_solver
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: A single SAT call may take longer than the whole budget,
+          hence the solver is told how much time is left.
+
+\*******************************************************************/
+
+void resource_limitst::limit_solver(propt &solver) const
+{
+  if(wall_time_limit<=0)
+    return;
+
+  double left=std::ceil(wall_time_limit-wall_time());
+
+  solver.set_time_limit_seconds(left<1?1:static_cast<uint32_t>(left));
+}
+
+/*******************************************************************\
+
+Function: resource_limitst::wall_time
+
+  Inputs:
+
+ Outputs: seconds since the start of the run
+
+ Purpose:
+
+\*******************************************************************/
+
+double resource_limitst::wall_time() const
+{
+  return std::chrono::duration<double>(
+    std::chrono::steady_clock::now()-start_time).count();
+}
+
+/*******************************************************************\
+
+Function: resource_limitst::cpu_time
+
+  Inputs:
+
+ Outputs: CPU seconds of all threads of the process
+
+ Purpose:
+
+\*******************************************************************/
+
+double resource_limitst::cpu_time()
+{
+  return static_cast<double>(std::clock())/CLOCKS_PER_SEC;
+}
+
+/*******************************************************************\
+
+Function: resource_limitst::resident_memory
+
+  Inputs:
+
+ Outputs: resident memory in MB
+
+ Purpose:
+
+\*******************************************************************/
+
+std::size_t resource_limitst::resident_memory()
+{
+  #ifdef __linux__
+  // the current size, not the peak
+  std::ifstream statm("/proc/self/statm");
+  std::size_t size, resident;
+
+  if(statm >> size >> resident)
+    return resident*sysconf(_SC_PAGESIZE)/(1024*1024);
+  #endif
+
+  #ifndef _WIN32
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+
+  #ifdef __APPLE__
+  return usage.ru_maxrss/(1024*1024); // bytes
+  #else
+  return usage.ru_maxrss/1024; // kilobytes
+  #endif
+  #else
+  return 0;
+  #endif
+}
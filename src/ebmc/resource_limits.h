@@ -0,0 +1,59 @@
+/*******************************************************************\
+
+Module: Resource Limits of the Engines
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+#ifndef CPROVER_EBMC_RESOURCE_LIMITS_H
+#define CPROVER_EBMC_RESOURCE_LIMITS_H
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+#include <util/cmdline.h>
+
+class propt;
+
+// The budgets given on the command line. The engines check them
+// in their main loops and stop gracefully, keeping the results
+// found so far. A limit of zero means that there is none. The
+// checks do not modify the object, so threads may share it.
+
+class resource_limitst
+{
+public:
+  explicit resource_limitst(const cmdlinet &);
+
+  // returns true if one of the limits is not a number
+  static bool check_options(const cmdlinet &, std::string &option);
+
+  double wall_time_limit;            // seconds, --time-limit
+  double cpu_time_limit;             // seconds, --cpu-limit
+  std::size_t memory_limit;          // MB of resident memory, --memory-limit
+  unsigned long long conflict_limit; // SAT conflicts, --conflict-limit
+  std::size_t bdd_node_limit;        // --bdd-node-limit
+
+  // time or memory
+  bool exhausted(std::string &reason) const;
+
+  bool conflicts_exhausted(
+    unsigned long long conflicts,
+    std::string &reason) const;
+
+  bool bdd_nodes_exhausted(std::size_t nodes, std::string &reason) const;
+
+  // interrupts the SAT solver when the wall-clock time is up
+  void limit_solver(propt &) const;
+
+  double wall_time() const;
+  static double cpu_time();
+  static std::size_t resident_memory();
+
+protected:
+  std::chrono::steady_clock::time_point start_time;
+};
+
+#endif
@@ -0,0 +1,191 @@
+/*******************************************************************\
+
+Module: Streaming the Results as JSON
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+#include <iostream>
+
+#include <util/json.h>
+
+#include "ebmc_base.h"
+
+// With --json-ui, stdout is a JSON array, which the message
+// handler writes as the run goes on. Every event is added to it
+// as one object when it happens. The "event" member says which
+// of the following it is; members are only ever added, never
+// renamed.
+//
+//  property:   "property", "status" (SUCCESS, FAILURE, UNKNOWN),
+//              "bound" (deepest bound without counterexample,
+//              if known), "time"
+//  trace:      "property", "trace" (the counterexample, as
+//              "mode" and "states" with the assignments)
+//  bound:      "bound", "time"
+//  statistics: "solver_time", "time", "cpu_time", "memory"
+//  batch:      "version" (--batch only, first)
+//  job:        "job", "result" (the exit code; --batch only)
+//
+// Times are in seconds since the start of the run (of the job
+// with --batch), "cpu_time" is that of the process and "memory"
+// is in MB.
+// Each property is reported exactly once.
+
+/*******************************************************************\
+
+Function: ebmc_baset::json_ui
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+bool ebmc_baset::json_ui() const
+{
+  return static_cast<ui_message_handlert *>(message_handler)->get_ui()==
+         ui_message_handlert::uit::JSON_UI;
+}
+
+/*******************************************************************\
+
+Function: ebmc_baset::push_json
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: adds the event to the JSON array of the message handler,
+          which keeps the output valid JSON
+
+\*******************************************************************/
+
+void ebmc_baset::push_json(const json_objectt &json)
+{
+  static_cast<ui_message_handlert *>(message_handler)->
+    get_json_stream().push_back(json);
+
+  std::cout << std::flush;
+}
+
+/*******************************************************************\
+
+Function: ebmc_baset::stream_result
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: Prints the result of the property, and its trace if
+          it failed, unless this has already been done.
+
+\*******************************************************************/
+
+void ebmc_baset::stream_result(propertyt &property)
+{
+  if(!json_ui() || property.is_disabled() || property.streamed)
+    return;
+
+  property.streamed=true;
+
+  json_objectt json_result;
+  json_result["event"]=json_stringt("property");
+  json_result["property"]=json_stringt(id2string(property.name));
+
+  switch(property.status)
+  {
+  case propertyt::statust::SUCCESS:
+    json_result["status"]=json_stringt("SUCCESS");
+    break;
+  case propertyt::statust::FAILURE:
+    json_result["status"]=json_stringt("FAILURE");
+    break;
+  case propertyt::statust::UNKNOWN:
+    json_result["status"]=json_stringt("UNKNOWN");
+    break;
+  case propertyt::statust::DISABLED:;
+  }
+
+  if(property.bound_reached)
+    json_result["bound"]=
+      json_numbert(std::to_string(*property.bound_reached));
+
+  json_result["time"]=json_numbert(std::to_string(limits.wall_time()));
+
+  push_json(json_result);
+
+  if(property.is_failure())
+  {
+    const namespacet ns(symbol_table);
+    const trans_tracet &trace=property.get_counterexample(ns);
+
+    // IC3 does not produce a trans_tracet
+    if(trace.states.empty())
+      return;
+
+    json_objectt json_trace;
+    json_trace["event"]=json_stringt("trace");
+    json_trace["property"]=json_stringt(id2string(property.name));
+    convert(ns, trace, json_trace["trace"].make_object());
+
+    push_json(json_trace);
+  }
+}
+
+/*******************************************************************\
+
+Function: ebmc_baset::stream_bound
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: All properties have been checked with the current bound.
+
+\*******************************************************************/
+
+void ebmc_baset::stream_bound()
+{
+  if(!json_ui() || !limit_reason.empty())
+    return;
+
+  json_objectt json_bound;
+  json_bound["event"]=json_stringt("bound");
+  json_bound["bound"]=json_numbert(std::to_string(bound));
+  json_bound["time"]=json_numbert(std::to_string(limits.wall_time()));
+
+  push_json(json_bound);
+}
+
+/*******************************************************************\
+
+Function: ebmc_baset::stream_statistics
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void ebmc_baset::stream_statistics(double solver_time)
+{
+  if(!json_ui())
+    return;
+
+  json_objectt json_statistics;
+  json_statistics["event"]=json_stringt("statistics");
+  json_statistics["solver_time"]=json_numbert(std::to_string(solver_time));
+  json_statistics["time"]=json_numbert(std::to_string(limits.wall_time()));
+  json_statistics["cpu_time"]=
+    json_numbert(std::to_string(resource_limitst::cpu_time()));
+  json_statistics["memory"]=
+    json_numbert(std::to_string(resource_limitst::resident_memory()));
+
+  push_json(json_statistics);
+}
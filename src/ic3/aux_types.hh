@@ -7,6 +7,9 @@ Author: Eugene Goldberg, eu.goldberg@gmail.com
 ******************************************************/
 
 #include <string>
+#include <unordered_map>
+#include <mutex>
+#include <atomic>
 
 #ifndef UNUSED
 #ifdef _MSC_VER
@@ -29,7 +32,20 @@ const Mbool Mtrue = IctMinisat::l_True;
 const Mbool Mfalse = IctMinisat::l_False;
 const Mbool Mundef = IctMinisat::l_Undef;
 
-typedef std::map<CLAUSE,int> ClauseTable;
+//
+//  ClauseTable
+//
+struct clause_hash {
+  size_t operator()(const CLAUSE &C) const
+  {
+    size_t h = C.size();
+    for (size_t i=0; i < C.size(); i++)
+      h = h*1000003 ^ (size_t) (unsigned) C[i];
+    return(h);
+  }
+};
+
+typedef std::unordered_map<CLAUSE,int,clause_hash> ClauseTable;
 typedef std::map<std::string,int> NameTable;
 typedef std::map<CCUBE,int> ConstrNames;
 
@@ -87,8 +103,10 @@ struct VarInfo{
 //  OblTable
 //
 struct OblTableElem {
-  CUBE St_cb; // state cube
-  CUBE Inp_assgn; // corresponding input assignment
+  int st_beg; // the state cube starts at Obl_lits[st_beg]
+  int st_size; // number of literals of the state cube
+  int inp_beg; // the input assignment starts at Obl_lits[inp_beg]
+  int inp_size; // number of literals of the input assignment
   int tf_ind; // time frame index
   int dist; // number of transitions of states of 'St_cube' from a bad state
   int succ_ind; // index of the successor state cube in 'Obl_table'
@@ -106,29 +124,34 @@ struct PqElem {
   int tf_ind; // time frame index, the same value as in OblTableElem
   int dist; //  the same value as in OblTableElem
   int tbl_ind; // index of this element in 'Obl_table'
-  int sort_mode; // specifies the sorting mode
+  int seq; // the later an element is queued, the larger 'seq' is
 };
 
-
-class pq_compare {
+// a d-ary heap of proof obligations indexed by 'tbl_ind'. Obligations
+// with smaller 'tf_ind' go first, then the ones with smaller 'dist',
+// then the ones queued earlier
+class PrQueue {
 public:
-  bool operator() (PqElem &A, PqElem &B)
-  {
-    if (A.tf_ind  > B.tf_ind) return(true);
-    if (A.tf_ind  < B.tf_ind) return(false);
-    if (A.dist > B.dist) return(true);
-    if (A.sort_mode == 0) return(false);
-    if (A.sort_mode == 1) {
-      if (A.tbl_ind > B.tbl_ind) return(true);
-      else return(false);}
-    assert(A.sort_mode == 2);
-    if (A.tbl_ind < B.tbl_ind) return(true);
-    else return(false);
-  }
+  PrQueue() : seq(0) {}
+  bool empty() {return(Heap.empty());}
+  size_t size() {return(Heap.size());}
+  PqElem &top() {return(Heap[0]);}
+  void push(int tbl_ind,int tf_ind,int dist);
+  void pop();
+  void requeue(int tbl_ind,int tf_ind);
+  void clear();
+private:
+  static const size_t D = 4; // number of children of a node
+  std::vector <PqElem> Heap;
+  std::vector <int> Pos; // Pos[tbl_ind] is the index of the element in
+                         // 'Heap' (-1 if it is not queued)
+  int seq;
+  bool before(PqElem &A,PqElem &B);
+  void place(size_t ind,PqElem &El);
+  void sift_up(size_t ind);
+  void sift_down(size_t ind);
 };
 
-typedef std::priority_queue<PqElem,std::vector <PqElem>, pq_compare> PrQueue;
-
 
 
 //
@@ -144,6 +167,11 @@ struct ClauseInfo
                        // to the next time frame
   unsigned skip : 1; // if set to 1, this clause should be ignored when 
                      // pushing clauses forward
+  unsigned long long sig; // bit (var % 64) is set for every variable of
+                          // the clause. Used to rule out subsumption quickly
+  int push_tf; // the time frame from which pushing the clause failed last
+               // (-1 if it has not failed)
+  long push_stamp; // value of 'clause_stamp' when pushing the clause failed
  
 };
 
@@ -161,6 +189,7 @@ struct SatSolver
   int init_num_vars;  // the initial number of variables
   int num_rel_vars; // number of released vars
   PrevOper prev_oper; // specifies the previous operation
+  long last_change; // value of 'clause_stamp' when a clause was added last
 };
 
 //
@@ -191,5 +220,27 @@ struct TimeFrame
  
 };
 
+//
+//   LemmaExchange
+//
+//   Clauses shared by the workers of parallel IC3. A clause is
+//   stored in the shard given by its hash, so workers adding
+//   different clauses rarely wait for each other
+//
 
+struct SharedLemma
+{
+  CLAUSE C; // the clause (in terms of present state variables)
+  int tf_ind; // the latest time frame where the clause is known to hold
+  int owner; // the worker that generated the clause
+};
+
+const int NUM_LEMMA_SHARDS = 16;
 
+struct LemmaExchange
+{
+  std::mutex Locks[NUM_LEMMA_SHARDS];
+  std::vector <SharedLemma> Shards[NUM_LEMMA_SHARDS];
+  std::atomic<bool> stop; // is set when a worker has solved the problem
+  std::atomic<int> winner; // the worker that solved the problem (or -1)
+};
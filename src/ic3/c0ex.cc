@@ -24,12 +24,14 @@ Author: Eugene Goldberg, eu.goldberg@gmail.com
 void CompInfo::form_inp_trace(DNF &Inp_trace)
 {
 
-  assert(Obl_table.size() > 0);
-  int succ_ind1 = Obl_table.size()-1;
+  assert(cex_tbl_ind >= 0);
+  int succ_ind1 = cex_tbl_ind;
   
 
   while (true) {
-    Inp_trace.push_back(Obl_table[succ_ind1].Inp_assgn);
+    CUBE Inps;
+    get_obl_inps(Inps,succ_ind1);
+    Inp_trace.push_back(Inps);
     succ_ind1 = Obl_table[succ_ind1].succ_ind;
     if (succ_ind1 < 0) return;
   }
@@ -24,6 +24,11 @@ Author: Eugene Goldberg, eu.goldberg@gmail.com
 void CompInfo::form_coi_array()
 {
 
+  if (N == NULL) {
+    form_coi_array_direct();
+    return;
+  }
+
   DNF Coi_arr;
 
   CUBE Coi;
@@ -149,4 +154,84 @@ void CompInfo::form_coi(CUBE &Coi,CUBE &Stack,hsh_tbl &Htbl)
 
 } /* end of function form_coi */
 
+/*=========================================
+
+   F O R M _ C O I _ A R R A Y _ D I R E C T
+
+  Same as 'form_coi_array' but for the
+  formulas generated without circuit N.
+  Here, Coi_arr consists of variables
+
+  ==========================================*/
+void CompInfo::form_coi_array_direct()
+{
+
+  DNF Coi_arr;
+  CUBE Coi;
+
+  CUBE Stack;
+  int out_var = abs(Prop.back()[0]);
+  Stack.push_back(out_var);
+
+  form_coi_direct(Coi,Stack,htable_lits);
+
+  if (Coi.size() == Pres_svars.size()) return;
+
+  Coi_arr.push_back(Coi);
+
+  size_t level = 0;
+  while (true) {
+    if (Coi_arr.size() > max_coi_depth) break;
+    CUBE Dcoi;
+    Stack.clear();
+    for (size_t i=0; i < Coi_arr[level].size(); i++) {
+      int var = Coi_arr[level][i];
+      Stack.push_back(Pres_to_next[var-1]+1);
+    }
+    form_coi_direct(Dcoi,Stack,htable_lits);
+    if (Dcoi.size() == Pres_svars.size()) break;
+    Coi_arr.push_back(Dcoi);
+    level++;
+  }
+
+  for (size_t i=0; i < Coi_arr.size(); i++)
+    Coi_svars.push_back(Coi_arr[i]);
+
+} /* end of function form_coi_array_direct */
+
+/*====================================
+
+     F O R M _ C O I _ D I R E C T
+
+  =====================================*/
+void CompInfo::form_coi_direct(CUBE &Coi,CUBE &Stack,hsh_tbl &Htbl)
+{
+
+  Htbl.change_marker();
+  Htbl.started_using();
+  int marker = Htbl.marker;
+  CUBE &Table = Htbl.Table;
+
+  for (size_t i=0; i < Stack.size(); i++)
+    Table[Stack[i]-1] = marker;
+
+  while (Stack.size() > 0) {
+    int var = Stack.back();
+    Stack.pop_back();
+    if (Fanin0[var-1] == 0) { // a latch or an input
+      if (Pres_to_next[var-1] >= 0) Coi.push_back(var);
+      continue;
+    }
+
+    int Lits[2] = {Fanin0[var-1],Fanin1[var-1]};
+    for (int i=0; i < 2; i++) {
+      int var1 = abs(Lits[i]);
+      if (Table[var1-1] == marker) continue;
+      Table[var1-1] = marker;
+      Stack.push_back(var1);
+    }
+  }
+
+  Htbl.done_using();
 
+} /* end of function form_coi_direct */
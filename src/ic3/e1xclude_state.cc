@@ -31,7 +31,10 @@ void CompInfo::exclude_state_cube(CNF &G,int &min_tf,CUBE &St0_cube,CUBE &Inps0)
 
 
   assert(Pr_queue.empty());
+  Pr_queue.clear();
   Obl_table.clear();
+  Obl_lits.clear();
+  cex_tbl_ind = -1;
 
   assert(tf_lind > 0);
   int curr_tf = tf_lind-1;
@@ -39,6 +42,7 @@ void CompInfo::exclude_state_cube(CNF &G,int &min_tf,CUBE &St0_cube,CUBE &Inps0)
   
   add_new_elem(St0_cube,Inps0,curr_tf,1,-1,ROOT_STATE);
   min_tf = curr_tf; 
+  CUBE St_cube;
   while (Pr_queue.size() > 0) {   
     if (verbose > 1)  {
       printf("Pr_queue.size() = %d\n",(int) Pr_queue.size());
@@ -50,12 +54,15 @@ void CompInfo::exclude_state_cube(CNF &G,int &min_tf,CUBE &St0_cube,CUBE &Inps0)
     if (verbose > 1)
       printf("curr_tf = %d, tbl_ind = %d, min_tf = %d\n",curr_tf,tbl_ind, min_tf);
 
-    CUBE St_cube  =  Obl_table[tbl_ind].St_cb;
+    get_obl_state(St_cube,tbl_ind);
     char st_descr = Obl_table[tbl_ind].st_descr;
 
 
     if (curr_tf == 0) 
-      if (cont_init_states(St_cube)) return;
+      if (cont_init_states(St_cube)) {
+        cex_tbl_ind = tbl_ind;
+        return;
+      }
 
     int dist = Obl_table[tbl_ind].dist;
     int st_ind = tf_lind + 1 - dist;
@@ -80,7 +87,6 @@ void CompInfo::exclude_state_cube(CNF &G,int &min_tf,CUBE &St0_cube,CUBE &Inps0)
     
 
     if (found) { // inductive clause is found      
-      Pr_queue.pop();
       if (verbose > 1) 	{	 
 	printf("Inductive clause F[%d] is found ",(int) F.size());
 	std::cout  << C << std::endl;
@@ -98,17 +104,10 @@ void CompInfo::exclude_state_cube(CNF &G,int &min_tf,CUBE &St0_cube,CUBE &Inps0)
 
       add_fclause1(C,tf_ind1,st_descr);
 
-      if (standard_mode) {
-	if (tf_ind1 <= tf_lind) {
-	  CUBE Inps = Obl_table[tbl_ind].Inp_assgn;
-	  add_new_elem(St_cube,Inps,tf_ind1,dist,succ_ind,OLD_STATE);
-	}
-      }
-      else
-	if (tf_ind1 < tf_lind) {
-	  CUBE Inps = Obl_table[tbl_ind].Inp_assgn;
-	  add_new_elem(St_cube,Inps,tf_ind1+1,dist,succ_ind,OLD_STATE);
-	}
+      // the obligation is re-enqueued at a later time frame
+      if (!standard_mode) tf_ind1++;
+      if (tf_ind1 <= tf_lind) requeue_elem(tbl_ind,tf_ind1);
+      else Pr_queue.pop();
      
       continue;
     }
@@ -131,7 +130,10 @@ void CompInfo::exclude_state_cube(CNF &G,int &min_tf,CUBE &St0_cube,CUBE &Inps0)
     }
     
     add_new_elem(Erl_st_cube,Erl_inps,curr_tf-1,dist+1,tbl_ind,NEW_STATE);
-    if (curr_tf == 0) return;
+    if (curr_tf == 0) {
+      cex_tbl_ind = Obl_table.size()-1;
+      return;
+    }
       
   }
 
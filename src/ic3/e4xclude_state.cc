@@ -144,8 +144,12 @@ void CompInfo::add_new_elem(CUBE &St_cube,CUBE &Inp_assgn,
   OblTableElem Dummy;
   Obl_table.push_back(Dummy);
   OblTableElem &El = Obl_table.back();
-  El.St_cb = St_cube;
-  El.Inp_assgn = Inp_assgn;
+  El.st_beg = Obl_lits.size();
+  El.st_size = St_cube.size();
+  Obl_lits.insert(Obl_lits.end(),St_cube.begin(),St_cube.end());
+  El.inp_beg = Obl_lits.size();
+  El.inp_size = Inp_assgn.size();
+  Obl_lits.insert(Obl_lits.end(),Inp_assgn.begin(),Inp_assgn.end());
   El.tf_ind = tf_ind;
   El.dist = dist;
   El.succ_ind = succ_ind;
@@ -160,16 +164,55 @@ void CompInfo::add_new_elem(CUBE &St_cube,CUBE &Inp_assgn,
     root_state_cnt++;
   }
   
-  PqElem El1;
-  El1.tf_ind = tf_ind;
-  El1.tbl_ind = Obl_table.size()-1;
-  El1.dist = dist;
-  El1.sort_mode = 1;
-  
-  Pr_queue.push(El1);
+  Pr_queue.push(Obl_table.size()-1,tf_ind,dist);
 
 } /* end of function add_new_elem */
 
+/*====================================
+
+      R E Q U E U E _ E L E M
+
+  Moves obligation 'tbl_ind' that is
+  on top of 'Pr_queue' to time frame
+  'tf_ind'. Its cubes are not copied
+
+  =====================================*/
+void CompInfo::requeue_elem(int tbl_ind,int tf_ind)
+{
+
+  OblTableElem &El = Obl_table[tbl_ind];
+  El.tf_ind = tf_ind;
+  El.st_descr = OLD_STATE;
+  old_state_cnt++;
+
+  Pr_queue.requeue(tbl_ind,tf_ind);
+
+} /* end of function requeue_elem */
+
+/*====================================
+
+      G E T _ O B L _ S T A T E
+
+  =====================================*/
+void CompInfo::get_obl_state(CUBE &St_cube,int tbl_ind)
+{
+  OblTableElem &El = Obl_table[tbl_ind];
+  CUBE::iterator pnt = Obl_lits.begin()+El.st_beg;
+  St_cube.assign(pnt,pnt+El.st_size);
+} /* end of function get_obl_state */
+
+/*====================================
+
+      G E T _ O B L _ I N P S
+
+  =====================================*/
+void CompInfo::get_obl_inps(CUBE &Inps,int tbl_ind)
+{
+  OblTableElem &El = Obl_table[tbl_ind];
+  CUBE::iterator pnt = Obl_lits.begin()+El.inp_beg;
+  Inps.assign(pnt,pnt+El.inp_size);
+} /* end of function get_obl_inps */
+
 
 
 
@@ -8,7 +8,8 @@ public:
   ic3_enginet(
 	      const cmdlinet &cmdline,
 	      ui_message_handlert &ui_message_handler):
-    ebmc_baset(cmdline, ui_message_handler)
+    ebmc_baset(cmdline, ui_message_handler),
+    bmc_bound(-1)
   {
   }
 
@@ -19,6 +20,7 @@ public:
   NondetVars Nondet_vars;
   bool const0,const1;
   bool orig_names;
+  int bmc_bound; // no counterexample up to this length (-1 if unknown)
 
   int operator()();
   void read_ebmc_input();  
@@ -52,7 +54,7 @@ public:
   void print_expr_id(exprt &E);
   bool banned_expr(exprt &expr);
   bool find_prop(propertyt &Prop);
-  void read_parameters();
+  bool read_parameters();
   void print_header();
   void form_init_constr_lits();
   void store_constraints(const std::string &fname);
@@ -61,6 +63,14 @@ public:
   void print_lit(std::ostream& out,literalt a);
   std::string print_string(const irep_idt &id);
   void add_verilog_conv_constrs();
+  void read_netlist_direct();
+  void form_direct_constr_nodes(CUBE &Constr_nodes);
+  void form_direct_constr_lits(SCUBE &Latch_vars);
+  bool bmc_hybrid_ok();
+  void unwind_netlist(bmc_mapt &Bmc_map,cnft &Solver,bvt &Prop_lits);
+  void bmc_seed_ic3();
+  int bmc_with_frames();
+  void report_verdict(int ret_val);
   
 protected:
   netlistt netlist;
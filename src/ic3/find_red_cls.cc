@@ -20,6 +20,12 @@ Author: Eugene Goldberg, eu.goldberg@gmail.com
 
   R E M _ R E D U N D _ C L A U S E S
 
+  Occurrence lists 'Flits0' and 'Flits1'
+  are maintained as clauses are added.
+  This function catches the clauses that
+  became subsumed by pushing clauses to
+  later time frames
+
   ====================================*/
 int CompInfo::rem_redund_clauses()
 {
@@ -27,28 +33,86 @@ int CompInfo::rem_redund_clauses()
   CUBE Old_nums;
   int count = 0;
   sort_in_length(Old_nums);
-  form_lit_arrays(Old_nums);
  
-
   for (size_t i=0; i < Old_nums.size(); i++) {
     int clause_ind = Old_nums[i];
     if (Clause_info[clause_ind].active == 0) continue;
-    CUBE Subsumed;
-    check_for_subsumed_clauses1(Subsumed,clause_ind);
-    count += Subsumed.size();
-    for (size_t j=0; j < Subsumed.size(); j++)
-      remove_clause(Subsumed[j]);
+    count += rem_subsumed_clauses(clause_ind);
   }
 
   return(count);
 } /* end of function rem_redund_clauses */
 
+/*===================================
+
+  R E M _ S U B S U M E D _ C L A U S E S
+
+  Removes the clauses of F subsumed
+  by F[clause_ind]. Returns the number
+  of removed clauses
+
+  ====================================*/
+int CompInfo::rem_subsumed_clauses(int clause_ind)
+{
+
+  CUBE Subsumed;
+  check_for_subsumed_clauses1(Subsumed,clause_ind);
+  for (size_t j=0; j < Subsumed.size(); j++)
+    remove_clause(Subsumed[j]);
+
+  return(Subsumed.size());
+
+} /* end of function rem_subsumed_clauses */
+
+/*===================================
+
+  S U B S U M E D _ B Y _ F C L A U S E
+
+  Returns 'true' if C is subsumed by an
+  active clause of F that is present in
+  time frame 'last_ind'
+
+  ====================================*/
+bool CompInfo::subsumed_by_fclause(CLAUSE &C,int last_ind)
+{
+
+  unsigned long long sig = clause_sig(C);
+
+  htable_lits.change_marker();
+  htable_lits.started_using();
+  mark_literals(htable_lits,C);
+
+  bool found = false;
+  for (size_t i=0; i < C.size(); i++) {
+    int lit = C[i];
+    CUBE &Clauses = (lit < 0) ? Flits0[-lit-1] : Flits1[lit-1];
+    for (size_t j=0; j < Clauses.size(); j++) {
+      int clause_ind = Clauses[j];
+      if (Clause_info[clause_ind].active == 0) continue;
+      if (Clause_info[clause_ind].span < (size_t) last_ind) continue;
+      if (F[clause_ind].size() > C.size()) continue;
+      if (Clause_info[clause_ind].sig & ~sig) continue;
+      if (subsumes(F[clause_ind],htable_lits)) {
+        found = true;
+        break;
+      }
+    }
+    if (found) break;
+  }
+
+  htable_lits.done_using();
+  return(found);
+
+} /* end of function subsumed_by_fclause */
+
 /*============================================
 
   F O R M _ L I T _ A R R A Y S 
 
+  Builds occurrence lists from scratch
+
   ============================================*/
-void CompInfo::form_lit_arrays(CUBE &Old_nums)
+void CompInfo::form_lit_arrays()
 {
 
   for (int i=0; i < max_pres_svar; i++)  {
@@ -56,19 +120,46 @@ void CompInfo::form_lit_arrays(CUBE &Old_nums)
     Flits1[i].clear();
   }
 
-  for (int i=Old_nums.size()-1; i>=0;i--) {
-    int clause_ind = Old_nums[i];
-    if (Clause_info[clause_ind].active == 0) continue;
-    CLAUSE &C = F[clause_ind];
-    for (size_t j=0; j < C.size(); j++) {
-      int var_ind = abs(C[j])-1;
-      if (C[j] < 0) Flits0[var_ind].push_back(clause_ind);
-      else Flits1[var_ind].push_back(clause_ind);
-    }
+  for (size_t i=0; i < F.size(); i++) {
+    if (Clause_info[i].active == 0) continue;
+    add_to_lit_arrays(i);
   }
 
 } /* end of function form_lit_arrays */
 
+/*============================================
+
+  A D D _ T O _ L I T _ A R R A Y S
+
+  ============================================*/
+void CompInfo::add_to_lit_arrays(int clause_ind)
+{
+
+  CLAUSE &C = F[clause_ind];
+  for (size_t j=0; j < C.size(); j++) {
+    int var_ind = abs(C[j])-1;
+    if (C[j] < 0) Flits0[var_ind].push_back(clause_ind);
+    else Flits1[var_ind].push_back(clause_ind);
+  }
+
+} /* end of function add_to_lit_arrays */
+
+/*============================================
+
+  C L A U S E _ S I G
+
+  ============================================*/
+unsigned long long clause_sig(CLAUSE &C)
+{
+
+  unsigned long long sig = 0;
+  for (size_t i=0; i < C.size(); i++)
+    sig |= 1ull << (abs(C[i]) % 64);
+
+  return(sig);
+
+} /* end of function clause_sig */
+
 /*===========================================
 
   S O R T _ I N _ L E N G T H
@@ -132,11 +223,14 @@ void CompInfo::check_for_subsumed_clauses1(CUBE &Subsumed,int clause_ind0)
   else pClauses = &Flits1[lit-1];
 
   size_t len = C.size();
+  unsigned long long sig0 = Clause_info[clause_ind0].sig;
   for (size_t i=0; i < pClauses->size(); i++) {
     int clause_ind1 = (*pClauses)[i];
     if (Clause_info[clause_ind1].active == 0) continue;
     if (Clause_info[clause_ind1].span > span0) continue;
-    if (F[clause_ind1].size() <= len) break;
+    if (Clause_info[clause_ind1].span == 0) continue; // initial states
+    if (F[clause_ind1].size() <= len) continue;
+    if (sig0 & ~Clause_info[clause_ind1].sig) continue;
     htable_lits.change_marker();
     htable_lits.started_using();
     mark_literals(htable_lits,F[clause_ind1]);
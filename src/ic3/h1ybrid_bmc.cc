@@ -0,0 +1,237 @@
+/******************************************************
+
+Module: Combining IC3 with BMC on the netlist
+
+Author: Eugene Goldberg, eu.goldberg@gmail.com
+
+******************************************************/
+#include <queue>
+#include <set>
+#include <map>
+#include <algorithm>
+#include <iostream>
+
+#include <ebmc/ebmc_base.h>
+#include <solvers/sat/satcheck.h>
+#include <trans-netlist/unwind_netlist.h>
+
+#include "minisat/core/Solver.h"
+#include "minisat/simp/SimpSolver.h"
+#include "dnf_io.hh"
+#include "ccircuit.hh"
+#include "m0ic3.hh"
+
+#include "ebmc_ic3_interface.hh"
+
+/*==================================
+
+   N E T L I S T _ L I T
+
+  Inverse of 'conv_lit'
+
+  ==================================*/
+literalt netlist_lit(int lit)
+{
+  return(literalt(abs(lit)-1,lit < 0));
+} /* end of function netlist_lit */
+
+/*==================================
+
+    B M C _ H Y B R I D _ O K
+
+  IC3 variables are mapped to the
+  nodes of the netlist only if the
+  CNFs are generated directly
+
+  ==================================*/
+bool ic3_enginet::bmc_hybrid_ok()
+{
+
+  if (Ci.N != NULL) return(false);
+  if (Ci.const_true_prop || Ci.const_false_prop) return(false);
+  return(true);
+
+} /* end of function bmc_hybrid_ok */
+
+/*==================================
+
+    U N W I N D _ N E T L I S T
+
+  Unwinds the netlist for 'bound'
+  transitions. Prop_lits[t] is the
+  property in time frame 't'
+
+  ==================================*/
+void ic3_enginet::unwind_netlist(bmc_mapt &Bmc_map,cnft &Solver,
+                                 bvt &Prop_lits)
+{
+
+  Bmc_map.map_timeframes(netlist,bound+1,Solver);
+  ::unwind(netlist,Bmc_map,*this,Solver);
+  ::unwind_property(Bmc_map,prop_l,Prop_lits);
+
+} /* end of function unwind_netlist */
+
+/*=====================================
+
+      B M C _ S E E D _ I C 3
+
+  Runs BMC for 'bound' transitions. If
+  no counterexample is found, the latch
+  values of the initial state that are
+  kept in the first 'bound' time frames
+  are passed to IC3 as unit clauses
+
+  =====================================*/
+void ic3_enginet::bmc_seed_ic3()
+{
+
+  if (!bmc_hybrid_ok()) {
+    printf("--bmc-hybrid is ignored (needs the CNFs generated directly\n");
+    printf("from the netlist and a non-constant property)\n");
+    Ci.bmc_hybrid_flag = false;
+    return;
+  }
+
+  get_bound();
+
+  satcheckt Solver{get_message_handler()};
+  bmc_mapt Bmc_map;
+  bvt Prop_lits;
+  unwind_netlist(Bmc_map,Solver,Prop_lits);
+
+  bvt Assmps;
+  Assmps.push_back(!Solver.land(Prop_lits));
+  Solver.set_assumptions(Assmps);
+  if (Solver.prop_solve() != propt::resultt::P_UNSATISFIABLE) {
+    // IC3 finds this counterexample quickly
+    if (Ci.verbose == 0)
+      printf("BMC: counterexample of length <= %u\n",bound);
+    return;
+  }
+
+  CNF Cands;
+  for (size_t i=0; i < Ci.Ist.size(); i++)
+    if (Ci.Ist[i].size() == 1) Cands.push_back(Ci.Ist[i]);
+
+  // drop the candidates falsified by a satisfying assignment
+  while (Cands.size() > 0) {
+    bvt Viol;
+    for (size_t i=0; i < Cands.size(); i++) {
+      literalt lit = netlist_lit(Cands[i][0]);
+      for (unsigned t=1; t <= bound; t++)
+        Viol.push_back(!Bmc_map.translate(t,lit));
+    }
+
+    Assmps.clear();
+    Assmps.push_back(Solver.lor(Viol));
+    Solver.set_assumptions(Assmps);
+    if (Solver.prop_solve() != propt::resultt::P_SATISFIABLE) break;
+
+    CNF Cands1;
+    for (size_t i=0; i < Cands.size(); i++) {
+      literalt lit = netlist_lit(Cands[i][0]);
+      bool kept = true;
+      for (unsigned t=1; t <= bound; t++)
+        if (!Solver.l_get(Bmc_map.translate(t,lit)).is_true()) {
+          kept = false;
+          break;
+        }
+      if (kept) Cands1.push_back(Cands[i]);
+    }
+    Cands = Cands1;
+  }
+
+  Ci.Bmc_lemmas = Cands;
+  if (Ci.verbose == 0)
+    printf("BMC: no counterexample of length <= %u, %d latch values kept\n",
+           bound,(int) Cands.size());
+
+} /* end of function bmc_seed_ic3 */
+
+/*=====================================
+
+    B M C _ W I T H _ F R A M E S
+
+  Is called when IC3 is undecided. Runs
+  BMC for 'bound' transitions. The state
+  of time frame 't' is constrained by the
+  clauses of F_t if the property holds
+  in time frames 0,..,t-1. (F_t over-
+  approximates the states reachable in
+  't' transitions along such paths.)
+
+  Returns the same values as 'run_ic3'
+
+  =====================================*/
+int ic3_enginet::bmc_with_frames()
+{
+
+  satcheckt Solver{get_message_handler()};
+  bmc_mapt Bmc_map;
+  bvt Prop_lits;
+  unwind_netlist(Bmc_map,Solver,Prop_lits);
+
+  int num_cls = 0;
+  for (unsigned t=1; t <= bound; t++) {
+    bvt Prefix(Prop_lits.begin(),Prop_lits.begin()+t);
+    literalt guard = Solver.land(Prefix);
+    for (size_t i=0; i < Ci.F.size(); i++) {
+      if (Ci.Clause_info[i].active == 0) continue;
+      if (Ci.Clause_info[i].span < t) continue;
+      CLAUSE &C = Ci.F[i];
+      bvt Lits;
+      for (size_t j=0; j < C.size(); j++)
+        Lits.push_back(Bmc_map.translate(t,netlist_lit(C[j])));
+      Lits.push_back(!guard);
+      Solver.lcnf(Lits);
+      num_cls++;
+    }
+  }
+
+  if (Ci.verbose == 0)
+    printf("BMC: %d clauses of F added to %u time frames\n",num_cls,bound);
+
+  bvt Assmps;
+  Assmps.push_back(!Solver.land(Prop_lits));
+  Solver.set_assumptions(Assmps);
+
+  switch (Solver.prop_solve()) {
+  case propt::resultt::P_SATISFIABLE:
+    printf("property FAILED (BMC, length <= %u)\n",bound);
+    return(1);
+  case propt::resultt::P_UNSATISFIABLE:
+    printf("BMC: no counterexample of length <= %u\n",bound);
+    bmc_bound = bound;
+    return(3);
+  default:
+    printf("BMC failed\n");
+    return(3);
+  }
+
+} /* end of function bmc_with_frames */
+
+/*==================================
+
+    U S E _ B M C _ L E M M A S
+
+  Adds to F_1 the clauses found by
+  'bmc_seed_ic3' that are implied
+  by Ist & Tr
+
+  ==================================*/
+void CompInfo::use_bmc_lemmas()
+{
+
+  int num_added = 0;
+  for (size_t i=0; i < Bmc_lemmas.size(); i++) {
+    CLAUSE &C = Bmc_lemmas[i];
+    if (!check_shared_lemma(C,1)) continue;
+    add_fclause1(C,1,PUSH_STATE);
+    num_added++;
+  }
+
+  if (verbose == 0)
+    printf("%d clauses found by BMC are added to F[1]\n",num_added);
+
+} /* end of function use_bmc_lemmas */
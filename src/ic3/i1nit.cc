@@ -31,6 +31,8 @@ void CompInfo::ci_init()
   Lit_act1.assign(max_pres_svar,0.);
   Tmp_act0.assign(max_pres_svar,0);
   Tmp_act1.assign(max_pres_svar,0);
+  Flits0.assign(max_pres_svar,CUBE());
+  Flits1.assign(max_pres_svar,CUBE());
 
   for (size_t i=0; i < Ist.size(); i++) 
     add_fclause2(Ist[i],0,false);
@@ -48,15 +50,13 @@ void CompInfo::ci_init()
   num_replaced_cases = 0;
  
 
-  for (int i=0; i < max_pres_svar; i++) {
-    CUBE Dummy;
-    Flits0.push_back(Dummy);
-    Flits1.push_back(Dummy);
-  }
-
+  cex_tbl_ind = -1;
   num_push_clause_calls = 0;
+  num_saved_push_calls = 0;
   num_bstate_cubes = 0; 
   length_bstate_cubes = 0.;  
+  num_tern_lifts = 0;
+  num_tern_fallbacks = 0;
   num_gstate_cubes = 0; 
   length_gstate_cubes = 0.; 
   old_state_cnt = 0;
@@ -195,9 +195,10 @@ void CompInfo::form_cex()
   if ((Cex.size() == 1) || (Cex.size() == 2))
     return; // trivial counterexample generated earlier
 
-  assert(Obl_table.size() > 0);
+  assert(cex_tbl_ind >= 0);
 
-  CUBE St_cube  =  Obl_table.back().St_cb;
+  CUBE St_cube;
+  get_obl_state(St_cube,cex_tbl_ind);
   form_init_st(St_cube);
   Cex.push_back(St_cube);
  
@@ -0,0 +1,329 @@
+/******************************************************
+
+Module: Reusing an invariant found by an earlier run
+
+Author: Eugene Goldberg, eu.goldberg@gmail.com
+
+******************************************************/
+#include <queue>
+#include <set>
+#include <map>
+#include <algorithm>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <stdint.h>
+#include "minisat/core/Solver.h"
+#include "minisat/simp/SimpSolver.h"
+#include "dnf_io.hh"
+#include "ccircuit.hh"
+#include "m0ic3.hh"
+
+/*==================================
+
+  A D D _ T O _ H A S H
+
+  =================================*/
+void add_to_hash(uint64_t &h,CNF &H)
+{
+  for (size_t i=0; i < H.size(); i++) {
+    for (size_t j=0; j <= H[i].size(); j++) {
+      // 0 terminates a clause
+      uint64_t val = (j < H[i].size()) ? (uint32_t) H[i][j] : 0;
+      for (int k=0; k < 4; k++) {
+        h ^= (val >> (8*k)) & 0xff;
+        h *= 1099511628211ull;
+      }
+    }
+  }
+  // separator
+  h ^= 0xff;
+  h *= 1099511628211ull;
+
+} /* end of function add_to_hash */
+
+/*==================================
+
+  I N V _ C A C H E _ K E Y
+
+  Returns a hash of the CNF formulas
+  describing the circuit and the
+  property. Unlike the file name, it
+  changes whenever the design does
+
+  =================================*/
+std::string CompInfo::inv_cache_key()
+{
+  uint64_t h = 14695981039346656037ull;
+
+  add_to_hash(h,Ist);
+  add_to_hash(h,Tr);
+  add_to_hash(h,Prop);
+  add_to_hash(h,Bad_states);
+
+  CNF Constrs;
+  for (size_t i=0; i < Constr_ilits.size(); i++) {
+    CLAUSE U;
+    U.push_back(Constr_ilits[i]);
+    Constrs.push_back(U);
+  }
+  add_to_hash(h,Constrs);
+
+  char buf[32];
+  snprintf(buf,sizeof(buf),"%016llx",(unsigned long long) h);
+  return(std::string(buf));
+
+} /* end of function inv_cache_key */
+
+/*==================================
+
+  I N V _ C A C H E _ F I L E
+
+  =================================*/
+std::string CompInfo::inv_cache_file()
+{
+  std::string Name = prop_name.empty() ? "property" : prop_name;
+
+  for (size_t i=0; i < Name.size(); i++)
+    if (!isalnum(Name[i]) && (Name[i] != '.') && (Name[i] != '_'))
+      Name[i] = '_';
+
+  return(inv_cache_dir + "/" + Name + ".inv");
+
+} /* end of function inv_cache_file */
+
+/*==================================
+
+  R E A D _ I N V _ C A C H E
+
+  Reads in the clauses stored by an
+  earlier run. Clauses with a variable
+  that is not a present state one are
+  dropped. 'same_key' is set to 'true'
+  if the circuit has not changed
+
+  =================================*/
+void CompInfo::read_inv_cache(CNF &H,bool &same_key)
+{
+  same_key = false;
+
+  std::ifstream in(inv_cache_file().c_str());
+  if (!in) return;
+
+  std::string Line;
+  if (!std::getline(in,Line)) return;
+
+  std::istringstream Header(Line);
+  std::string C_mark,Key_mark,Key;
+  if (!(Header >> C_mark >> Key_mark >> Key)) return;
+  if ((C_mark != "c") || (Key_mark != "key")) return;
+
+  same_key = (Key == inv_cache_key());
+
+  while (std::getline(in,Line)) {
+    std::istringstream Lits(Line);
+    CLAUSE C;
+    int lit;
+    bool ok = true;
+    while ((Lits >> lit) && (lit != 0)) {
+      size_t var_ind = abs(lit)-1;
+      if ((var_ind >= Pres_to_next.size()) || (Pres_to_next[var_ind] < 0))
+        ok = false;
+      C.push_back(lit);
+    }
+    if (ok && (C.size() > 0)) H.push_back(C);
+  }
+
+} /* end of function read_inv_cache */
+
+/*==================================
+
+  W R I T E _ I N V _ C A C H E
+
+  =================================*/
+void CompInfo::write_inv_cache()
+{
+  CNF H;
+  gen_form1(H,inv_ind+1);
+
+  std::string Fname = inv_cache_file();
+  FILE *fp = fopen(Fname.c_str(),"w");
+  if (fp == NULL) {
+    printf("cannot open file %s\n",Fname.c_str());
+    return;
+  }
+
+  fprintf(fp,"c key %s\n",inv_cache_key().c_str());
+  for (size_t i=0; i < H.size(); i++) {
+    for (size_t j=0; j < H[i].size(); j++)
+      fprintf(fp,"%d ",H[i][j]);
+    fprintf(fp,"0\n");
+  }
+
+  fclose(fp);
+
+} /* end of function write_inv_cache */
+
+/*==================================
+
+  R E M _ N O N _ I N I T _ C L A U S E S
+
+  Removes the clauses of H that exclude
+  an initial state
+
+  =================================*/
+void CompInfo::rem_non_init_clauses(CNF &H)
+{
+  std::string Name = "Gen_sat";
+  init_sat_solver(Gen_sat,max_num_vars,Name);
+  accept_new_clauses(Gen_sat,Ist);
+  accept_constrs(Gen_sat);
+
+  CNF H1;
+  for (size_t i=0; i < H.size(); i++) {
+    MvecLits Assmps;
+    add_negated_assumps1(Assmps,H[i]);
+    if (check_sat2(Gen_sat,Assmps)) continue;
+    H1.push_back(H[i]);
+  }
+
+  delete_solver(Gen_sat);
+  H = H1;
+
+} /* end of function rem_non_init_clauses */
+
+/*==================================
+
+  C H E C K _ I N V _ C A N D S
+
+  Checks with one SAT call whether
+  H & Prop & Tr implies H' & Prop'
+  (or just H' if 'with_bad' is false).
+  To this end, the clauses of H' and
+  'Bad_states' are negated with the
+  help of activation variables
+
+  Returns 'true' if the implication
+  holds. Otherwise, the clauses of H
+  falsified by the satisfying
+  assignment are removed
+
+  =================================*/
+bool CompInfo::check_inv_cands(CNF &H,bool with_bad)
+{
+  std::string Name = "Gen_sat";
+  init_sat_solver(Gen_sat,max_num_vars,Name);
+
+  if (use_short_prop)  accept_new_clauses(Gen_sat,Short_prop);
+  else accept_new_clauses(Gen_sat,Prop);
+  accept_new_clauses(Gen_sat,Tr);
+  accept_new_clauses(Gen_sat,H);
+
+  TrivMclause Disj;
+
+  // a bad next state
+  if (with_bad) {
+    Mlit bad_lit = IctMinisat::mkLit(Gen_sat.Mst->newVar(),false);
+    for (size_t i=0; i < Bad_states.size(); i++) {
+      TrivMclause A;
+      conv_to_mclause(A,Bad_states[i]);
+      A.push(~bad_lit);
+      Gen_sat.Mst->addClause(A);
+    }
+    Disj.push(bad_lit);
+  }
+
+  // a next state falsifying a clause of H
+  DNF Next_cls;
+  for (size_t i=0; i < H.size(); i++) {
+    CLAUSE C;
+    conv_to_next_state(C,H[i]);
+    Next_cls.push_back(C);
+    Mlit act_lit = IctMinisat::mkLit(Gen_sat.Mst->newVar(),false);
+    for (size_t j=0; j < C.size(); j++) {
+      TrivMclause A;
+      A.push(~act_lit);
+      A.push(~conv_to_mlit(C[j]));
+      Gen_sat.Mst->addClause(A);
+    }
+    Disj.push(act_lit);
+  }
+
+  Gen_sat.Mst->addClause(Disj);
+
+  bool sat_form = check_sat1(Gen_sat);
+  if (sat_form == false) {
+    delete_solver(Gen_sat);
+    return(true);
+  }
+
+  MboolVec &S = Gen_sat.Mst->model;
+  CNF H1;
+  for (size_t i=0; i < H.size(); i++) {
+    bool falsified = true;
+    for (size_t j=0; j < Next_cls[i].size(); j++) {
+      int lit = Next_cls[i][j];
+      bool val = (S[abs(lit)-1] == Mtrue);
+      if (val == (lit > 0)) {
+        falsified = false;
+        break;
+      }
+    }
+    if (!falsified) H1.push_back(H[i]);
+  }
+
+  delete_solver(Gen_sat);
+  H = H1;
+  return(false);
+
+} /* end of function check_inv_cands */
+
+/*==================================
+
+  U S E _ I N V _ C A C H E
+
+  Adds to F the clauses of the stored
+  invariant that are still inductive.
+  If they still imply the property,
+  the first time frame finds the
+  invariant without proof obligations
+
+  =================================*/
+void CompInfo::use_inv_cache()
+{
+  CNF H;
+  bool same_key;
+  read_inv_cache(H,same_key);
+  if (H.size() == 0) return;
+
+  size_t num_read = H.size();
+  rem_non_init_clauses(H);
+
+  // the largest subset of H that is inductive relative to Prop
+  bool inv_found = false;
+  bool with_bad = true;
+  while (H.size() > 0) {
+    size_t old_size = H.size();
+    if (check_inv_cands(H,with_bad)) {
+      inv_found = with_bad;
+      break;
+    }
+    // only the property failed to be inductive
+    if (H.size() == old_size) {
+      assert(with_bad);
+      with_bad = false;
+    }
+  }
+
+  if (verbose == 0) {
+    printf("cached invariant: %d clauses read, %d kept",(int) num_read,
+           (int) H.size());
+    if (inv_found) printf(", property proved");
+    if (!same_key) printf(" (circuit changed)");
+    printf("\n");
+  }
+
+  for (size_t i=0; i < H.size(); i++)
+    add_fclause1(H[i],1,PUSH_STATE);
+
+} /* end of function use_inv_cache */
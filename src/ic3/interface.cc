@@ -27,7 +27,10 @@ bool CompInfo::check_sat1(SatSolver &Slvr)
 
   Slvr.num_calls++;
   Slvr.tot_num_calls++;
-  return(Slvr.Mst->solve());
+  uint64_t conflicts0 = Slvr.Mst->conflicts;
+  bool sat_form = Slvr.Mst->solve();
+  num_conflicts += Slvr.Mst->conflicts - conflicts0;
+  return(sat_form);
 
 } /* end of function check_sat1 */
 
@@ -41,7 +44,10 @@ bool CompInfo::check_sat2(SatSolver &Slvr,MvecLits &Assmps)
 
   Slvr.num_calls++;
   Slvr.tot_num_calls++;
-  return(Slvr.Mst->solve(Assmps));
+  uint64_t conflicts0 = Slvr.Mst->conflicts;
+  bool sat_form = Slvr.Mst->solve(Assmps);
+  num_conflicts += Slvr.Mst->conflicts - conflicts0;
+  return(sat_form);
 
 } /* end of function check_sat2 */
 
@@ -86,5 +92,6 @@ void CompInfo::init_sat_solver(SatSolver &Slvr,int nvars,std::string &Id_name)
   Slvr.num_rel_vars = 0;
   Slvr.num_calls = 0;
   Slvr.Mst = S;
+  Slvr.last_change = ++clause_stamp;
 
 } /* end of function init_sat_solver */
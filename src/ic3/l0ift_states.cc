@@ -48,6 +48,15 @@ void CompInfo::lift_good_state(CUBE &Gst_cube,CUBE &Prs_st,
 
   CUBE Prs_st1;
   rem_constr_lits(Prs_st1,Prs_st,Constr_ps_lits);  
+
+  if (tern_lift_ok() && tern_lift(Gst_cube,Prs_st1,Inps,Nst_cube)) {
+    release_lit(Lgs_sat,~act_lit);
+    num_gstate_cubes++;
+    length_gstate_cubes += Gst_cube.size();
+    add_constr_lits1(Gst_cube);
+    return;
+  }
+
   add_assumps2(Assmps,Prs_st1);
   
   bool sat_form = check_sat2(Lgs_sat,Assmps);
@@ -88,6 +97,18 @@ void CompInfo::lift_bad_state(CUBE &Bst_cube,CUBE &St,CUBE &Inps)
 
   CUBE St1;
   rem_constr_lits(St1,St,Constr_ps_lits);
+
+  if (tern_lift_ok()) {
+    CUBE Targ_lits;
+    Targ_lits.push_back(Fanin0.size()); // the output variable
+    if (tern_lift(Bst_cube,St1,Inps,Targ_lits)) {
+      num_bstate_cubes++;
+      length_bstate_cubes += Bst_cube.size();
+      add_constr_lits1(Bst_cube);
+      return;
+    }
+  }
+
   add_assumps2(Assmps,St1);
 
  
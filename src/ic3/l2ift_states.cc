@@ -0,0 +1,228 @@
+/******************************************************
+
+Module: Lifting states by ternary simulation
+        (Part 3)
+
+Author: Eugene Goldberg, eu.goldberg@gmail.com
+
+******************************************************/
+#include <iostream>
+#include <queue>
+#include <set>
+#include <map>
+#include <algorithm>
+#include "minisat/core/Solver.h"
+#include "minisat/simp/SimpSolver.h"
+#include "dnf_io.hh"
+#include "ccircuit.hh"
+#include "m0ic3.hh"
+
+/*==================================
+
+      T E R N _ L I F T _ O K
+
+  Ternary simulation needs the gates
+  of the netlist. Constraints on
+  internal variables are not taken
+  into account by simulation
+
+  ==================================*/
+bool CompInfo::tern_lift_ok()
+{
+
+  if (tern_lift_flag == false) return(false);
+  if (N != NULL) return(false);
+  if (Fun_coi_lits.size() > 0) return(false);
+  if (Tr_coi_lits.size() > 0) return(false);
+  return(true);
+
+} /* end of function tern_lift_ok */
+
+/*==================================
+
+      I N I T _ T E R N _ S I M
+
+  ==================================*/
+void CompInfo::init_tern_sim()
+{
+
+  size_t num_vars = Fanin0.size();
+  Tval.assign(num_vars,2);
+  Tqueued.assign(num_vars,0);
+  Ttargets.assign(num_vars,0);
+  Fanouts.assign(num_vars,CUBE());
+
+  for (size_t i=0; i < num_vars; i++) {
+    if (Fanin0[i] == 0) continue;
+    int var = i+1;
+    Fanouts[abs(Fanin0[i])-1].push_back(var);
+    if (abs(Fanin1[i]) != abs(Fanin0[i]))
+      Fanouts[abs(Fanin1[i])-1].push_back(var);
+  }
+
+} /* end of function init_tern_sim */
+
+/*==================================
+
+      T E R N _ L I T _ V A L
+
+  ==================================*/
+char CompInfo::tern_lit_val(int lit)
+{
+  char val = Tval[abs(lit)-1];
+  if (val == 2) return(2);
+  if (lit < 0) return(1-val);
+  return(val);
+} /* end of function tern_lit_val */
+
+/*==================================
+
+      T E R N _ G A T E _ V A L
+
+  ==================================*/
+char CompInfo::tern_gate_val(int var)
+{
+  char val0 = tern_lit_val(Fanin0[var-1]);
+  char val1 = tern_lit_val(Fanin1[var-1]);
+  if ((val0 == 0) || (val1 == 0)) return(0);
+  if ((val0 == 1) && (val1 == 1)) return(1);
+  return(2);
+} /* end of function tern_gate_val */
+
+/*======================================
+
+      T E R N _ D R O P _ V A R
+
+  Sets 'var' to X and propagates the
+  change in topological order. Returns
+  'false' if a target variable becomes X.
+  The changed variables are stored in
+  'Changed' as literals of old values
+
+  =====================================*/
+bool CompInfo::tern_drop_var(int var,CUBE &Changed)
+{
+
+  Changed.clear();
+  if (Tval[var-1] == 1) Changed.push_back(var);
+  else Changed.push_back(-var);
+  Tval[var-1] = 2;
+
+  std::priority_queue<int,std::vector<int>,std::greater<int> > Queue;
+  for (size_t i=0; i < Fanouts[var-1].size(); i++) {
+    int var1 = Fanouts[var-1][i];
+    Tqueued[var1-1] = 1;
+    Queue.push(var1);
+  }
+
+  bool ok = true;
+  while (Queue.size() > 0) {
+    int var1 = Queue.top();
+    Queue.pop();
+    Tqueued[var1-1] = 0;
+    if (!ok) continue;
+    if (Tval[var1-1] == 2) continue;
+    if (tern_gate_val(var1) != 2) continue;
+
+    if (Tval[var1-1] == 1) Changed.push_back(var1);
+    else Changed.push_back(-var1);
+    Tval[var1-1] = 2;
+    if (Ttargets[var1-1]) {
+      ok = false;
+      continue;
+    }
+
+    for (size_t i=0; i < Fanouts[var1-1].size(); i++) {
+      int var2 = Fanouts[var1-1][i];
+      if (Tqueued[var2-1]) continue;
+      Tqueued[var2-1] = 1;
+      Queue.push(var2);
+    }
+  }
+
+  return(ok);
+
+} /* end of function tern_drop_var */
+
+/*======================================
+
+    T E R N _ L I F T _ S T A T E
+
+  Finds a subcube 'St_cube' of 'St' such
+  that every state of 'St_cube' under
+  'Inps' satisfies 'Targ_lits'. Returns
+  'false' if simulation of 'St' itself
+  does not produce 'Targ_lits'
+
+  =====================================*/
+bool CompInfo::tern_lift_state(CUBE &St_cube,CUBE &St,CUBE &Inps,
+                               CUBE &Targ_lits)
+{
+
+  if (Tval.size() == 0) init_tern_sim();
+
+  size_t num_vars = Fanin0.size();
+  for (size_t i=0; i < num_vars; i++) Tval[i] = 2;
+  Tval[0] = 0; // constant 'false'
+
+  for (size_t i=0; i < Inps.size(); i++)
+    Tval[abs(Inps[i])-1] = (Inps[i] > 0);
+  for (size_t i=0; i < St.size(); i++)
+    Tval[abs(St[i])-1] = (St[i] > 0);
+
+  for (size_t i=0; i < num_vars; i++)
+    if (Fanin0[i] != 0) Tval[i] = tern_gate_val(i+1);
+
+  bool ok = true;
+  for (size_t i=0; i < Targ_lits.size(); i++) {
+    if (tern_lit_val(Targ_lits[i]) != 1) ok = false;
+    Ttargets[abs(Targ_lits[i])-1] = 1;
+  }
+
+  if (ok) {
+    CUBE Changed;
+    for (size_t i=0; i < St.size(); i++) {
+      if (tern_drop_var(abs(St[i]),Changed)) continue;
+      // restore old values
+      for (size_t j=0; j < Changed.size(); j++)
+        Tval[abs(Changed[j])-1] = (Changed[j] > 0);
+      St_cube.push_back(St[i]);
+    }
+  }
+
+  for (size_t i=0; i < Targ_lits.size(); i++)
+    Ttargets[abs(Targ_lits[i])-1] = 0;
+
+  return(ok);
+
+} /* end of function tern_lift_state */
+
+/*======================================
+
+      T E R N _ L I F T
+
+  Returns 'true' if ternary simulation
+  dropped enough literals of 'St1'.
+  Otherwise, 'St1' is replaced with the
+  cube to be lifted by the SAT-solver
+
+  ====================================*/
+bool CompInfo::tern_lift(CUBE &St_cube,CUBE &St1,CUBE &Inps,CUBE &Targ_lits)
+{
+
+  CUBE Cube;
+  if (!tern_lift_state(Cube,St1,Inps,Targ_lits)) return(false);
+
+  int num_dropped = St1.size()-Cube.size();
+  if (num_dropped*100 >= tern_min_drop*(int) St1.size()) {
+    St_cube = Cube;
+    num_tern_lifts++;
+    return(true);
+  }
+
+  // let the SAT-solver drop more literals
+  St1 = Cube;
+  num_tern_fallbacks++;
+  return(false);
+
+} /* end of function tern_lift */
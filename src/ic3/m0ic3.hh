@@ -8,6 +8,7 @@ Author: Eugene Goldberg, eu.goldberg@gmail.com
 #include "aux_types.hh"
 
 extern int debug_flag;
+class resource_limitst;
 /*================================
 
   C L A S S   C O M P _ I N F O
@@ -33,6 +34,16 @@ public:
  
   int num_circ_vars; // number of variables assigned to gates of N
 
+  // used if CNFs are generated from the netlist directly (N == NULL)
+  CUBE Fanin0; // Fanin0[var-1] and Fanin1[var-1] are the input literals
+  CUBE Fanin1; // of the gate of 'var'. Fanin0[var-1] == 0 for inputs and latches
+  int num_gates;
+  // ternary simulation (used to lift states)
+  CCUBE Tval; // Tval[var-1] is 0, 1 or 2 (i.e. X)
+  DNF Fanouts; // Fanouts[var-1] lists the gates fed by 'var'
+  CCUBE Tqueued; // Tqueued[var-1] == 1 if 'var' is in the simulation queue
+  CCUBE Ttargets; // Ttargets[var-1] == 1 if 'var' has to stay binary
+
   CUBE Pres_svars; // array specifying the current state variables
   CUBE Next_svars; // array specifying the next state variables
   DNF Coi_svars; // Coi_svars[i] spec. the vars that are in the cone influence
@@ -145,6 +156,10 @@ public:
 
   PrQueue Pr_queue; // priority queue of proof obligations
   OblTable Obl_table; // table of proof obligations
+  CUBE Obl_lits; // literals of the state cubes and input assignments
+                 // of 'Obl_table'
+  int cex_tbl_ind; // the obligation of 'Obl_table' containing an
+                   // initial state
 
   DNF Cex; // a counterexample in terms of states extracted from 'Obl_table'
 
@@ -181,6 +196,15 @@ public:
                                // invariant consisting of inductive clauses
   long int excl_st_count; // number of times the exclude_state
   // procedure is called
+  int num_workers; // if num_workers > 1, IC3 is run by 'num_workers'
+                   // threads sharing the clauses they derive
+  std::string inv_cache_dir; // if not empty, the invariant is stored in
+                             // and read from this directory
+  bool bmc_hybrid_flag; // if 'true', BMC is run before IC3 and after IC3
+                        // fails to finish
+  CNF Bmc_lemmas; // clauses that hold in the first time frames (found by BMC)
+  const resource_limitst *Limits; // limits set in ebmc (NULL if none)
+  std::string Limit_reason; // the limit that stopped IC3
   int time_limit; // if time_limit > 0, the program terminates when the run
                   //  time exceeds 'time_limit' seconds
   bool use_short_prop; // if true, the program uses 'Short_prop' instead of
@@ -202,6 +226,9 @@ public:
                          // are sorted when looking for an inductive clause
   int gate_sort_mode; // value of this variable controls the ordering of
                       // gates of the circuit used to generate formulas
+  bool tern_lift_flag; // if 'true', states are lifted by ternary simulation
+  int tern_min_drop; // if ternary simulation drops less than 'tern_min_drop'
+                     // percent of literals, the SAT-solver drops more
   size_t max_coi_depth; // the maximum number of time frames unfolded when 
                      // computing the cone of influence
   bool ctg_flag; // if 'true' generalization based on computing counterexamples
@@ -220,6 +247,21 @@ public:
   
  
 
+  // ------------- Parallel IC3
+  LemmaExchange *Lex; // shared by all workers (NULL if there is only one)
+  int worker_ind; // index of this worker
+  CUBE Lex_read; // Lex_read[i] is the number of elements of shard 'i' seen
+  int num_shared_lemmas; // number of clauses sent to other workers
+  int num_imported_lemmas; // number of clauses of other workers added to F
+
+  // ------------- Pushing clauses
+  long clause_stamp; // incremented whenever a clause is added to a SAT-solver
+  CDNF Push_cexs; // next states (in present state variables) that falsified
+                  // clauses pushed from time frame 'push_cex_tf'
+  int push_cex_tf; // time frame of the states of 'Push_cexs'
+  long push_cex_stamp; // value of 'clause_stamp' when 'Push_cexs' was valid
+  int max_push_cexs; // maximal size of 'Push_cexs'
+
   // ------------- Debugging
   CUBE Glob_lits; 
   
@@ -274,6 +316,9 @@ protected:
   int num_bstate_cubes; // number of times a bad state has been lifted
   float length_bstate_cubes;  // number of lengths of the bad state cubes 
                               // after lifting
+  int num_tern_lifts; // number of states lifted by ternary simulation alone
+  int num_tern_fallbacks; // number of states where ternary simulation was
+                          // followed by SAT-based lifting
   int num_gstate_cubes; // number of times a good state has been lifted
   float length_gstate_cubes; // number of length of the good state cubes
                              //  after lifting
@@ -298,6 +343,9 @@ protected:
   int max_num_impr; // specifies the maximum number of improvements for an
                       // inductive clause
   int num_push_clause_calls; // contains the number of sat calls to push clauses
+  unsigned long long num_conflicts; // conflicts of all SAT calls
+  int num_saved_push_calls; // number of pushes that were known to fail
+                            // without a sat call
   int num_inact_cls; // specifies the number of clauses of F that are currently
                      //  inactive
   int num_add1_cases; // number of cases where 'replce_or_add_clause' returned 
@@ -359,11 +407,12 @@ bool overlap(CUBE &A,CLAUSE &B);
 int parse_string(CCUBE &Buff);
 void print_names_of_latches(NamesOfLatches &Latches);
 bool ident_arrays(CUBE &A,CUBE &B);
+unsigned long long clause_sig(CLAUSE &C);
 void print_blif2(FILE *fp,Circuit *N);
 void print_blif3(const char *Name,Circuit *N);
 
-extern long long gcount;
-extern hsh_tbl htable_lits;
+extern thread_local long long gcount;
+extern thread_local hsh_tbl htable_lits;
 
 const int RESTORE = 0;
 const int REPLACED=1;
@@ -403,6 +452,7 @@ const char ROOT_STATE = 2;
 const char CTG_STATE = 3;
 const char PUSH_STATE = 4;
 const char UNKNOWN_STATE = 5;
+const char SHARED_STATE = 6;
 
 // values of 'grl_heur'
 const int NO_JOINS = 0;
@@ -22,8 +22,8 @@ Author: Eugene Goldberg, eu.goldberg@gmail.com
 #include <util/cmdline.h>
 #include "ebmc_ic3_interface.hh"
 
-hsh_tbl htable_lits;
-long long gcount = 0;
+thread_local hsh_tbl htable_lits;
+thread_local long long gcount = 0;
 
 
 /*=====================
@@ -50,7 +50,7 @@ int ic3_enginet::operator()()
 
 
   Ci.init_parameters();
-  read_parameters();
+  if (read_parameters()) return(1);
 
   try    {
     int result=get_model();
@@ -90,10 +90,44 @@ int ic3_enginet::operator()()
   }
   
   //  printf("Constr_gates.size() = %d\n",Ci.Constr_gates.size()); 
-  return(Ci.run_ic3());
+  if (Ci.bmc_hybrid_flag) bmc_seed_ic3();
+  int ret_val = Ci.run_ic3();
+  if ((ret_val == 3) && Ci.bmc_hybrid_flag) ret_val = bmc_with_frames();
+  report_verdict(ret_val);
+  return(ret_val);
 
 } /* end of function operator */
 
+/*==================================
+
+    R E P O R T _ V E R D I C T
+
+  Sets the status of the property
+  checked by IC3, streams it
+  (--json-ui) and stores it
+  (--incremental)
+
+  ==================================*/
+void ic3_enginet::report_verdict(int ret_val)
+{
+
+  for (auto &Prop : properties) {
+    if (id2string(Prop.name) != Ci.prop_name) continue;
+    if (ret_val == 1) Prop.make_failure();
+    else if (ret_val == 2) Prop.make_success();
+    else {
+      Prop.make_unknown();
+      // 'bmc_with_frames' may have gone deeper than IC3
+      int reached = std::max(Ci.tf_lind-1,bmc_bound);
+      if (reached >= 0) Prop.bound_reached = reached;
+    }
+    stream_result(Prop);
+  }
+
+  if (cmdline.isset("incremental")) store_results();
+
+} /* end of function report_verdict */
+
 /* ======================
 
        R U N _ I C 3
@@ -110,7 +144,9 @@ int CompInfo::run_ic3()
   assign_var_type();
   assign_value();
   get_runtime (usrtime0, systime0);
-  int res = mic3();
+  int res;
+  if (num_workers > 1) res = par_mic3();
+  else res = mic3();
   get_runtime (usrtime, systime);  
 
   int ret_val;
@@ -129,6 +165,8 @@ int CompInfo::run_ic3()
     if (print_clauses_flag)
       print_fclauses();
     bool ok = ver_trans_inv();
+    if (ok && (inv_cache_dir.size() > 0))
+      write_inv_cache();
     if (ok) ret_val = 2;
     else ret_val = 12;
     break;}
@@ -148,6 +186,9 @@ int CompInfo::run_ic3()
     break;}
   case 2:
     printf("UNDECided\n");
+    if (Limit_reason.size() > 0)
+      printf("resource limit reached (%s)\n",Limit_reason.c_str());
+    printf("no counterexample of length < %d\n",tf_lind);
     ret_val = 3;
     if (print_clauses_flag) 
       print_fclauses();
@@ -201,6 +242,8 @@ int CompInfo::mic3()
 
   if (ctg_flag) form_coi_array();
   tf_lind = 1;
+  if (inv_cache_dir.size() > 0) use_inv_cache();
+  if (Bmc_lemmas.size() > 0) use_bmc_lemmas();
  
 
   init_lbs_sat_solver();
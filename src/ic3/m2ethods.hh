@@ -27,6 +27,8 @@ void add_new_clauses(SatSolver &Slvr,CUBE &Clauses);
 void adjust_clause1(CLAUSE &C,CUBE &St);
 bool corr_clause(CLAUSE &C);
 bool push_clause(CLAUSE &C,int tf_ind,int clause_ind);
+bool push_fails(int tf_ind,int clause_ind);
+void store_push_cex(int tf_ind,int clause_ind);
 bool ver_ini_states(CNF &H);
 bool ver_prop();
 bool ver_ind_clauses1(CNF &H);
@@ -34,6 +36,15 @@ bool ver_ind_clauses2(CNF &H,CUBE &Old_nums);
 bool ver_invar(CNF &H,CUBE &Old_nums);
 void gen_form1(CNF &H,int k);
 void gen_form2(CNF &H,CUBE &Old_nums,int k);
+//
+std::string inv_cache_key();
+std::string inv_cache_file();
+void read_inv_cache(CNF &H,bool &same_key);
+void write_inv_cache();
+void rem_non_init_clauses(CNF &H);
+bool check_inv_cands(CNF &H,bool with_bad);
+void use_inv_cache();
+void use_bmc_lemmas();
 bool check_init_state(CUBE &St);
 bool check_transition(CUBE &St0,CUBE &St1);
 bool check_bad_state(CUBE &St);
@@ -65,6 +76,13 @@ void lift_good_state(CUBE &Gst_cube,CUBE &Pst,CUBE &Inps,CLAUSE &Nst_cube);
 void extr_next_inps(CUBE &Inps,SatSolver &Slvr);
 void check_overlapping();
 void gen_state_cube(CUBE &St_cube,CUBE &St,SatSolver &Slvr);
+bool tern_lift_ok();
+void init_tern_sim();
+char tern_lit_val(int lit);
+char tern_gate_val(int var);
+bool tern_drop_var(int var,CUBE &Changed);
+bool tern_lift_state(CUBE &St_cube,CUBE &St,CUBE &Inps,CUBE &Targ_lits);
+bool tern_lift(CUBE &St_cube,CUBE &St1,CUBE &Inps,CUBE &Targ_lits);
 void form_init_st(CUBE &St_cube);
 void form_missing_nxt_svars();
 void add_time_frame();
@@ -75,6 +93,9 @@ void add_one_copy(int tf_ind,CLAUSE &C);
 void form_inp_trace(DNF &Inp_trace);
 void add_new_elem(CUBE &St_cube,CUBE &Inp_assgn,int tf_ind,int dist,
                  int succ_ind,char descr);
+void requeue_elem(int tbl_ind,int tf_ind);
+void get_obl_state(CUBE &St_cube,int tbl_ind);
+void get_obl_inps(CUBE &Inps,int tbl_ind);
 void check_conv_tbl(CUBE &Vars,CUBE &Tbl,bool pres_svars);
 bool oblig_is_active(int tf_ind,CUBE &St_cube);
 bool cont_init_states(CUBE &St_cube);
@@ -90,7 +111,16 @@ void init_fields();
 void remove_clause(int clause_ind);
 int rem_redund_clauses();
 void sort_in_length(CUBE &Old_nums);
-void form_lit_arrays(CUBE &Old_nums);
+void form_lit_arrays();
+void add_to_lit_arrays(int clause_ind);
+int rem_subsumed_clauses(int clause_ind);
+bool subsumed_by_fclause(CLAUSE &C,int last_ind);
+int par_mic3();
+void set_worker_heur(int ind);
+void delete_worker_solvers();
+void share_lemma(CLAUSE &C,int tf_ind);
+void import_lemmas(CNF &G);
+bool check_shared_lemma(CLAUSE &C,int tf_ind);
 int find_best_ind2(CLAUSE &C);
 void check_for_subsumed_clauses1(CUBE &Subsumed,int clause_ind);
 void mark_literals(hsh_tbl &Ht,CLAUSE &C);
@@ -98,6 +128,7 @@ void clean_clause_set();
 void clean_formula();
 void build_new_clause_table();
 void recomp_tf_cls_sets();
+void rebuild_tf_solvers();
 void print_flags();
 int find_inact_lit(CLAUSE &Curr,SCUBE &Tried,FltCube &Act0,FltCube &Act1);
 int find_inact_var(CLAUSE &Curr,SCUBE &Tried,FltCube &Act0,FltCube &Act1);
@@ -152,6 +183,10 @@ void form_coi_array();
 void form_coi(CUBE &Coi,CUBE &Stack,hsh_tbl &Htbl);
 void conv_gates_to_svars(DNF &Coi_arr);
 void form_stack(CUBE &Stack,CUBE &Latches);
+void form_coi_array_direct();
+void form_coi_direct(CUBE &Coi,CUBE &Stack,hsh_tbl &Htbl);
+void mark_cone(CCUBE &Marks,int var,char flag);
+void add_gate_clauses(CNF &H,int var);
 void use_coi_to_drop_svars(CUBE &Nxt_cube,CUBE &Nxt_st,int dist);
 void extr_cut_assgns1(CUBE &Assgns,CUBE &Vars,SatSolver &Slvr);
 void extr_cut_assgns2(CUBE &Assgns,CUBE &Lits,SatSolver &Slv);
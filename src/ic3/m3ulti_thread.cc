@@ -0,0 +1,227 @@
+/******************************************************
+
+Module: Running IC3 by several threads that share
+        the clauses they derive
+
+Author: Eugene Goldberg, eu.goldberg@gmail.com
+
+******************************************************/
+#include <iostream>
+#include <queue>
+#include <set>
+#include <map>
+#include <algorithm>
+#include <thread>
+#include "minisat/core/Solver.h"
+#include "minisat/simp/SimpSolver.h"
+#include "dnf_io.hh"
+#include "ccircuit.hh"
+#include "m0ic3.hh"
+
+/*==================================
+
+      R U N _ W O R K E R
+
+  ==================================*/
+void run_worker(CompInfo *Ci,int *res)
+{
+
+  *res = Ci->mic3();
+  if ((*res == 0) || (*res == 1)) {
+    int none = -1;
+    Ci->Lex->winner.compare_exchange_strong(none,Ci->worker_ind);
+    Ci->Lex->stop = true;
+  }
+
+} /* end of function run_worker */
+
+/*==================================
+
+      P A R _ M I C 3
+
+  Runs 'num_workers' copies of mic3.
+  Worker 0 is this object. If another
+  worker solves the problem first, its
+  data replace the data of this object
+
+  Returns the same values as 'mic3'
+
+  ==================================*/
+int CompInfo::par_mic3()
+{
+
+  LemmaExchange Exch;
+  Exch.stop = false;
+  Exch.winner = -1;
+
+  Lex = &Exch;
+  std::vector <CompInfo> Workers(num_workers-1,*this);
+
+  std::vector <int> Res(num_workers,2);
+  std::vector <std::thread> Threads;
+  for (size_t i=0; i < Workers.size(); i++) {
+    Workers[i].set_worker_heur(i+1);
+    Threads.push_back(std::thread(run_worker,&Workers[i],&Res[i+1]));
+  }
+
+  set_worker_heur(0);
+  run_worker(this,&Res[0]);
+
+  for (size_t i=0; i < Threads.size(); i++)
+    Threads[i].join();
+
+  // the solvers of the winner (or of worker 0) are kept
+  int winner = Exch.winner;
+  for (size_t i=0; i < Workers.size(); i++)
+    if ((int) i+1 != winner) Workers[i].delete_worker_solvers();
+
+  if (winner > 0) {
+    delete_worker_solvers();
+    *this = Workers[winner-1];}
+  Lex = NULL;
+
+  if (winner < 0) return(2);
+  if (verbose == 0) printf("solved by worker %d\n",winner);
+  return(Res[winner]);
+
+} /* end of function par_mic3 */
+
+/*==================================
+
+  D E L E T E _ W O R K E R _ S O L V E R S
+
+  Deletes the SAT-solvers that 'mic3'
+  leaves: those of the time frames
+  and, if 'mic3' was interrupted, the
+  one of 'next_time_frame'
+
+  ==================================*/
+void CompInfo::delete_worker_solvers()
+{
+
+  for (size_t i=0; i < Time_frames.size(); i++)
+    if (Time_frames[i].Slvr.prev_oper == INIT)
+      delete_solver(Time_frames[i].Slvr);
+
+  // 'prev_oper' is only set once the solver has been created
+  if (Name_table.find("Bst_sat") != Name_table.end())
+    if (Bst_sat.prev_oper == INIT) delete_solver(Bst_sat);
+
+} /* end of function delete_worker_solvers */
+
+/*==================================
+
+    S E T _ W O R K E R _ H E U R
+
+  Workers use different heuristics
+  for shortening inductive clauses
+
+  ==================================*/
+void CompInfo::set_worker_heur(int ind)
+{
+
+  worker_ind = ind;
+  Lex_read.assign(NUM_LEMMA_SHARDS,0);
+  num_shared_lemmas = 0;
+  num_imported_lemmas = 0;
+
+  if (ind > 0) verbose = -1; // only worker 0 prints out progress
+
+  switch (ind % 4) {
+  case 0:
+    break;
+  case 1:
+    lit_pick_heur = INACT_LIT;
+    break;
+  case 2:
+    lit_pick_heur = RAND_LIT;
+    break;
+  case 3:
+    ctg_flag = false;
+    break;
+  }
+
+} /* end of function set_worker_heur */
+
+/*==================================
+
+     S H A R E _ L E M M A
+
+  ==================================*/
+void CompInfo::share_lemma(CLAUSE &C,int tf_ind)
+{
+
+  SharedLemma El;
+  El.C = C;
+  El.tf_ind = tf_ind;
+  El.owner = worker_ind;
+
+  int shard = clause_hash()(C) % NUM_LEMMA_SHARDS;
+  std::lock_guard<std::mutex> Guard(Lex->Locks[shard]);
+  Lex->Shards[shard].push_back(El);
+  num_shared_lemmas++;
+
+} /* end of function share_lemma */
+
+/*==================================
+
+     I M P O R T _ L E M M A S
+
+  Adds to F the clauses of other
+  workers that are inductive relative
+  to this worker's time frames.
+  Clauses added to time frame 'tf_lind'
+  are also returned in G
+
+  ==================================*/
+void CompInfo::import_lemmas(CNF &G)
+{
+
+  for (int i=0; i < NUM_LEMMA_SHARDS; i++) {
+    std::vector <SharedLemma> Lemmas;
+    {
+      std::lock_guard<std::mutex> Guard(Lex->Locks[i]);
+      std::vector <SharedLemma> &Shard = Lex->Shards[i];
+      Lemmas.assign(Shard.begin()+Lex_read[i],Shard.end());
+      Lex_read[i] = Shard.size();
+    }
+
+    for (size_t j=0; j < Lemmas.size(); j++) {
+      SharedLemma &El = Lemmas[j];
+      if (El.owner == worker_ind) continue;
+      int tf_ind = std::min(El.tf_ind,tf_lind);
+      CLAUSE &C = El.C;
+      sort(C.begin(),C.end());
+      ClauseTable::iterator pnt = Clause_table.find(C);
+      if (pnt != Clause_table.end())
+        if (Clause_info[pnt->second].span >= (size_t) tf_ind) continue;
+
+      if (!check_shared_lemma(C,tf_ind)) continue;
+      add_fclause1(C,tf_ind,SHARED_STATE);
+      num_imported_lemmas++;
+      if (tf_ind == tf_lind) G.push_back(C);
+    }
+  }
+
+} /* end of function import_lemmas */
+
+/*=========================================
+
+    C H E C K _ S H A R E D _ L E M M A
+
+  Returns 'true' if F[tf_ind-1] & Tr
+  implies C'. Then C can be added to
+  time frames 1,..,tf_ind
+
+  ========================================*/
+bool CompInfo::check_shared_lemma(CLAUSE &C,int tf_ind)
+{
+
+  SatSolver &Slvr = Time_frames[tf_ind-1].Slvr;
+  MvecLits Assmps;
+  add_negated_assumps2(Assmps,C,false);
+
+  bool sat_form = check_sat2(Slvr,Assmps);
+  return(!sat_form);
+
+} /* end of function check_shared_lemma */
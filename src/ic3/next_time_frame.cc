@@ -17,6 +17,8 @@ Author: Eugene Goldberg, eu.goldberg@gmail.com
 #include "ccircuit.hh"
 #include "m0ic3.hh"
 
+#include <ebmc/resource_limits.h>
+
 /*================================
 
   N E X T _ T I M E _ F R A M E
@@ -47,6 +49,11 @@ int CompInfo::next_time_frame()
 
   bool triv_time_frame = true;
   while (true) {
+    if (Lex != NULL) {
+      CNF G1;
+      import_lemmas(G1);
+      accept_new_clauses(Bst_sat,G1);
+    }
     bool sat_form = check_sat1(Bst_sat);
     if (sat_form == false) {
       ret_val = 2;
@@ -99,6 +106,7 @@ int CompInfo::next_time_frame()
   if (ret_val != 2)   return(ret_val);  
 
   if (rem_subsumed_flag) rem_redund_clauses();  
+  if (num_inact_cls*4 > (int) F.size()) clean_clause_set();
   simplify_tf_solvers();
   Lgs_sat.Mst->simplify();
   push_clauses_forward(triv_time_frame); 
@@ -123,11 +131,16 @@ int CompInfo::next_time_frame()
   ==========================================*/
 bool CompInfo::time_to_terminate() {
   excl_st_count++;
+  if ((Lex != NULL) && Lex->stop) return(true);
   if (time_limit > 0) {
     double usrtime,systime;
     get_runtime (usrtime, systime);
     if (usrtime > time_limit) return(true);
   }
+  if (Limits != NULL) {
+    if (Limits->exhausted(Limit_reason)) return(true);
+    if (Limits->conflicts_exhausted(num_conflicts,Limit_reason)) return(true);
+  }
   return(false);
 } /* end of function time_to_terminate */
 
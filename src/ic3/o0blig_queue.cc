@@ -0,0 +1,170 @@
+/******************************************************
+
+Module: Priority queue of proof obligations
+
+Author: Eugene Goldberg, eu.goldberg@gmail.com
+
+******************************************************/
+#include <iostream>
+#include <queue>
+#include <set>
+#include <map>
+#include <algorithm>
+#include "minisat/core/Solver.h"
+#include "minisat/simp/SimpSolver.h"
+#include "dnf_io.hh"
+#include "ccircuit.hh"
+#include "m0ic3.hh"
+
+/*==================================
+
+         B E F O R E
+
+  Returns 'true' if A has to be
+  processed before B. Obligations
+  with the same time frame and
+  distance are processed in the
+  order they were queued
+
+  ==================================*/
+bool PrQueue::before(PqElem &A,PqElem &B)
+{
+  if (A.tf_ind != B.tf_ind) return(A.tf_ind < B.tf_ind);
+  if (A.dist != B.dist) return(A.dist < B.dist);
+  return(A.seq < B.seq);
+} /* end of function before */
+
+/*==================================
+
+         P L A C E
+
+  ==================================*/
+void PrQueue::place(size_t ind,PqElem &El)
+{
+  Heap[ind] = El;
+  Pos[El.tbl_ind] = ind;
+} /* end of function place */
+
+/*==================================
+
+        S I F T _ U P
+
+  ==================================*/
+void PrQueue::sift_up(size_t ind)
+{
+
+  PqElem El = Heap[ind];
+  while (ind > 0) {
+    size_t par_ind = (ind-1)/D;
+    if (!before(El,Heap[par_ind])) break;
+    place(ind,Heap[par_ind]);
+    ind = par_ind;
+  }
+
+  place(ind,El);
+
+} /* end of function sift_up */
+
+/*==================================
+
+       S I F T _ D O W N
+
+  ==================================*/
+void PrQueue::sift_down(size_t ind)
+{
+
+  PqElem El = Heap[ind];
+  while (true) {
+    size_t first = D*ind+1;
+    if (first >= Heap.size()) break;
+    size_t last = std::min(first+D,Heap.size());
+    size_t best = first;
+    for (size_t i=first+1; i < last; i++)
+      if (before(Heap[i],Heap[best])) best = i;
+    if (!before(Heap[best],El)) break;
+    place(ind,Heap[best]);
+    ind = best;
+  }
+
+  place(ind,El);
+
+} /* end of function sift_down */
+
+/*==================================
+
+          P U S H
+
+  ==================================*/
+void PrQueue::push(int tbl_ind,int tf_ind,int dist)
+{
+
+  if (Pos.size() <= (size_t) tbl_ind) Pos.resize(tbl_ind+1,-1);
+  assert(Pos[tbl_ind] < 0);
+
+  PqElem El;
+  El.tf_ind = tf_ind;
+  El.dist = dist;
+  El.tbl_ind = tbl_ind;
+  El.seq = seq++;
+
+  Heap.push_back(El);
+  sift_up(Heap.size()-1);
+
+} /* end of function push */
+
+/*==================================
+
+           P O P
+
+  ==================================*/
+void PrQueue::pop()
+{
+
+  assert(Heap.size() > 0);
+  Pos[Heap[0].tbl_ind] = -1;
+
+  PqElem El = Heap.back();
+  Heap.pop_back();
+  if (Heap.size() == 0) return;
+
+  place(0,El);
+  sift_down(0);
+
+} /* end of function pop */
+
+/*==================================
+
+        R E Q U E U E
+
+  Moves a queued obligation to time
+  frame 'tf_ind'. The obligation is
+  treated as if it was queued anew
+
+  ==================================*/
+void PrQueue::requeue(int tbl_ind,int tf_ind)
+{
+
+  int ind = Pos[tbl_ind];
+  assert(ind >= 0);
+
+  PqElem &El = Heap[ind];
+  El.tf_ind = tf_ind;
+  El.seq = seq++;
+  sift_up(ind);
+  sift_down(Pos[tbl_ind]);
+
+} /* end of function requeue */
+
+/*==================================
+
+          C L E A R
+
+  The memory is kept to be reused
+  by the next set of obligations
+
+  ==================================*/
+void PrQueue::clear()
+{
+  Heap.clear();
+  Pos.clear();
+} /* end of function clear */
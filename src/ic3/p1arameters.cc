@@ -11,6 +11,8 @@ Author: Eugene Goldberg, eu.goldberg@gmail.com
 #include <algorithm>
 #include <iostream>
 
+#include <util/string2int.h>
+
 #include <ebmc/ebmc_base.h>
 
 #include "minisat/core/Solver.h"
@@ -26,8 +28,11 @@ Author: Eugene Goldberg, eu.goldberg@gmail.com
 
       R E A D _ P A R A M E T E R S
 
+  Returns true if a parameter is
+  malformed
+
  =====================================*/
-void ic3_enginet::read_parameters()
+bool ic3_enginet::read_parameters()
 {
 
   if (cmdline.isset("h")) {
@@ -45,6 +50,30 @@ void ic3_enginet::read_parameters()
 
   if (cmdline.isset("new-mode"))
     Ci.standard_mode = false;
+
+  if (cmdline.isset("inv-cache"))
+    Ci.inv_cache_dir = cmdline.get_value("inv-cache");
+
+  if (cmdline.isset("ternary-lift"))
+    Ci.tern_lift_flag = true;
+
+  if (cmdline.isset("bmc-hybrid"))
+    Ci.bmc_hybrid_flag = true;
+
+  if (cmdline.isset("num-threads")) {
+    std::string Val = cmdline.get_value("num-threads");
+    // 'unsafe_string2unsigned' accepts "-1" and "x" too
+    if (Val.empty() || (Val.find_first_not_of("0123456789") != std::string::npos)) {
+      error() << "--num-threads expects a positive number" << eom;
+      return(true);}
+    Ci.num_workers = unsafe_string2unsigned(Val);
+    if (Ci.num_workers == 0) {
+      error() << "--num-threads expects a positive number" << eom;
+      return(true);}
+  }
+
+  Ci.Limits = &limits;
+  return(false);
 } /* end of function read_parameters */
 
 /*==============================
@@ -55,9 +84,17 @@ void ic3_enginet::read_parameters()
 void ic3_enginet::print_header()
 {
 
-  printf("ebmc verilog_file --ic3 [--prop nm] [--constr]\n");
+  printf("ebmc verilog_file --ic3 [--prop nm] [--constr] [--inv-cache dir]\n");
+  printf("     [--via-circuit] [--ternary-lift] [--num-threads n]\n");
+  printf("     [--bmc-hybrid [--bound k]]\n");
   printf("prop nm - check property with name 'nm'\n");
   printf("constr  - use constraints listed in 'verilog_file.cnstr'\n");
+  printf("inv-cache dir - store the invariant in 'dir' and reuse it\n");
+  printf("via-circuit - build an intermediate circuit to generate CNFs\n");
+  printf("ternary-lift - lift states by ternary simulation\n");
+  printf("num-threads n - run n workers sharing derived clauses\n");
+  printf("bmc-hybrid - run BMC for k transitions before IC3 and,\n");
+  printf("             if IC3 is undecided, again using its clauses\n");
 } /* end of function print_header */
 
 /*=====================================
@@ -68,6 +105,7 @@ void ic3_enginet::print_header()
 void CompInfo::init_parameters()
 {
 
+  N = NULL;
   print_inv_flag = false;
   print_only_ind_clauses = 0;
   print_cex_flag = 0;
@@ -76,6 +114,8 @@ void CompInfo::init_parameters()
   gcount_max = -1;
   fin_tf = -1;
   time_limit = -1;
+  Limits = NULL;
+  num_conflicts = 0;
   use_short_prop = true;
   stat_data = 1;
   selector = 0;  
@@ -96,8 +136,19 @@ void CompInfo::init_parameters()
   max_ctg_cnt = 3;
   max_rec_depth = 1;
   max_coi_depth = 10;
+  tern_lift_flag = false;
+  num_workers = 1;
+  Lex = NULL;
+  worker_ind = 0;
+  tern_min_drop = 25;
+  clause_stamp = 0;
+  push_cex_tf = -1;
+  push_cex_stamp = 0;
+  max_push_cexs = 8;
   constr_flag = false;
   standard_mode = true;
+  inv_cache_dir = "";
+  bmc_hybrid_flag = false;
   
   } /* end of function init_parameters */
 
@@ -43,11 +43,18 @@ void CompInfo::push_clauses_forward(bool triv_time_frame)
       if (Clause_info[clause_ind].skip) continue;
       if (Clause_info[clause_ind].span != i) continue;    
 
+      if (push_fails(i,clause_ind)) {
+	Clause_info[clause_ind].skip = 1;
+	num_saved_push_calls++;
+	continue;
+      }
+
       CLAUSE C;
      
       bool ok = push_clause(C,i,clause_ind);
       if (!ok) {
 	Clause_info[clause_ind].skip = 1;
+	store_push_cex(i,clause_ind);
 	continue;
       }
 
@@ -67,6 +74,7 @@ void CompInfo::push_clauses_forward(bool triv_time_frame)
 	else if (ans == ADD2) {	 
 	  add_fclause2(C,i+1,true);
 	  add_copies(i,C);
+	  if (Lex != NULL) share_lemma(C,i+1);
 	  continue;}
       }
       else  // C.size() == F[clause_ind].size()
@@ -82,6 +90,7 @@ void CompInfo::push_clauses_forward(bool triv_time_frame)
 	Time_frames[i].num_bnd_cls--;
 	Time_frames[i+1].num_bnd_cls++;
 	Time_frames[i+1].Clauses.push_back(clause_ind);
+	if (Lex != NULL) share_lemma(F[clause_ind],i+1);
       }
      
      
@@ -134,6 +143,92 @@ bool CompInfo::push_clause(CLAUSE &C,int tf_ind,int clause_ind)
   return(true);
 } /* end of function push_clause */
 
+/*=============================
+
+  P U S H _ F A I L S
+
+  Returns 'true' if pushing
+  F[clause_ind] from time frame
+  'tf_ind' is known to fail. This
+  is the case if it failed before
+  and no clause has been added to
+  the SAT-solver since then, or if
+  a next state stored after an
+  earlier failure falsifies the
+  clause
+
+  ============================*/
+bool CompInfo::push_fails(int tf_ind,int clause_ind)
+{
+
+  ClauseInfo &El = Clause_info[clause_ind];
+  SatSolver &Slvr = Time_frames[tf_ind].Slvr;
+
+  if ((El.push_tf == tf_ind) && (Slvr.last_change <= El.push_stamp))
+    return(true);
+
+  if ((push_cex_tf != tf_ind) || (Slvr.last_change > push_cex_stamp)) {
+    Push_cexs.clear();
+    return(false);
+  }
+
+  CLAUSE &C = F[clause_ind];
+  for (size_t i=0; i < Push_cexs.size(); i++) {
+    CCUBE &Cex = Push_cexs[i];
+    bool falsified = true;
+    for (size_t j=0; j < C.size(); j++) {
+      int lit = C[j];
+      if (Cex[abs(lit)-1] == (lit > 0)) {
+        falsified = false;
+        break;
+      }
+    }
+    if (falsified) {
+      El.push_tf = tf_ind;
+      El.push_stamp = clause_stamp;
+      return(true);
+    }
+  }
+
+  return(false);
+
+} /* end of function push_fails */
+
+/*=================================
+
+  S T O R E _ P U S H _ C E X
+
+  Is called after pushing F[clause_ind]
+  from time frame 'tf_ind' failed.
+  Stores the next state found by the
+  SAT-solver to check the clauses
+  pushed later without a SAT call
+
+  ================================*/
+void CompInfo::store_push_cex(int tf_ind,int clause_ind)
+{
+
+  ClauseInfo &El = Clause_info[clause_ind];
+  El.push_tf = tf_ind;
+  El.push_stamp = clause_stamp;
+
+  if (push_cex_tf != tf_ind) Push_cexs.clear();
+  push_cex_tf = tf_ind;
+  push_cex_stamp = clause_stamp;
+  if ((int) Push_cexs.size() >= max_push_cexs) return;
+
+  MboolVec &S = Time_frames[tf_ind].Slvr.Mst->model;
+  CCUBE Cex(max_pres_svar,2);
+  for (size_t i=0; i < Pres_svars.size(); i++) {
+    int var = Pres_svars[i];
+    int next_var = Pres_to_next[var-1]+1;
+    Cex[var-1] = (S[next_var-1] == Mtrue);
+  }
+
+  Push_cexs.push_back(Cex);
+
+} /* end of function store_push_cex */
+
 
 /*===============================================
 
@@ -191,6 +286,8 @@ int CompInfo::replace_or_add_clause(int clause_ind,CLAUSE &C,int tf_ind)
   Clause_table.erase(pnt2);
  
   F[clause_ind] = C;
+  Clause_info[clause_ind].sig = clause_sig(C);
+  Clause_info[clause_ind].push_tf = -1;
 
   if (clause_ind1 == -1) {
     Clause_table[C] = clause_ind;   
@@ -31,6 +31,12 @@ void ic3_enginet::read_ebmc_input()
 {
 
   store_constraints(cmdline.args[0]);
+
+  // names are needed only for printing out the circuit
+  if (!cmdline.isset("aiger") && !cmdline.isset("via-circuit")) {
+    read_netlist_direct();
+    return;
+  }
  
   form_orig_names();
  
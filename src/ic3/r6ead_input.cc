@@ -91,7 +91,13 @@ bool ic3_enginet::find_prop(propertyt &Prop)
   assert(properties.size() > 0);
 
   if ((properties.size() >= 1) && (Ci.prop_name.size() == 0)) {
+    // skip the properties reused by --incremental
     Prop = properties.front();
+    for (const auto &p : properties)
+      if (!p.is_skipped()) {
+        Prop = p;
+        break;
+      }
     Ci.prop_name = id2string(Prop.name);
     return(true);
   }
@@ -0,0 +1,318 @@
+/******************************************************
+
+Module: Converting the netlist directly into CNF
+        formulas (without building circuit N)
+
+Author: Eugene Goldberg, eu.goldberg@gmail.com
+
+******************************************************/
+#include <queue>
+#include <set>
+#include <map>
+#include <algorithm>
+#include <iostream>
+
+#include <ebmc/ebmc_base.h>
+
+#include "minisat/core/Solver.h"
+#include "minisat/simp/SimpSolver.h"
+#include "dnf_io.hh"
+#include "ccircuit.hh"
+#include "m0ic3.hh"
+
+#include "ebmc_ic3_interface.hh"
+
+/*=============================
+
+      C O N V _ L I T
+
+  The variable of AIG node 'n'
+  is 'n+1'. Node 0 is constant
+  'false', hence variable 1 is
+  always 0
+
+  =============================*/
+int conv_lit(literalt lit)
+{
+  int var = lit.var_no()+1;
+  if (lit.sign()) return(-var);
+  return(var);
+} /* end of function conv_lit */
+
+/*=====================================
+
+  R E A D _ N E T L I S T _ D I R E C T
+
+  Generates 'Tr', 'Ist' and 'Prop' from
+  the AIG of the netlist. Next state
+  variables and the output variable
+  are numbered after the AIG nodes
+
+  =====================================*/
+void ic3_enginet::read_netlist_direct()
+{
+
+  ebmc_form_latches();
+  find_prop_lit();
+
+  aigt::nodest &Nodes = netlist.nodes;
+  var_mapt &vm = netlist.var_map;
+
+  bvt Latch_lits,Next_lits;
+  for(var_mapt::mapt::const_iterator it=vm.map.begin();
+      it!=vm.map.end(); it++)    {
+    const var_mapt::vart &var=it->second;
+    if (var.vartype !=var_mapt::vart::vartypet::LATCH)
+      continue;
+    for (size_t j=0; j < var.bits.size(); j++) {
+      literalt lit = var.bits[j].current;
+      assert(!lit.sign() && Nodes[lit.var_no()].is_var());
+      Latch_lits.push_back(lit);
+      Next_lits.push_back(var.bits[j].next);
+    }
+  }
+
+  int next_var0 = Nodes.size()+1;
+  int out_var = next_var0 + Latch_lits.size();
+
+  // the gates, next state variables are buffers
+  Ci.Fanin0.assign(out_var,0);
+  Ci.Fanin1.assign(out_var,0);
+  for (size_t i=1; i < Nodes.size(); i++) {
+    if (!Nodes[i].is_and()) continue;
+    Ci.Fanin0[i] = conv_lit(Nodes[i].a);
+    Ci.Fanin1[i] = conv_lit(Nodes[i].b);
+  }
+
+  for (size_t i=0; i < Next_lits.size(); i++) {
+    int var_ind = next_var0+i-1;
+    Ci.Fanin0[var_ind] = conv_lit(Next_lits[i]);
+    Ci.Fanin1[var_ind] = Ci.Fanin0[var_ind];
+  }
+
+  // the output is the negation of the property
+  Ci.Fanin0[out_var-1] = -conv_lit(prop_l);
+  Ci.Fanin1[out_var-1] = Ci.Fanin0[out_var-1];
+  Ci.const_true_prop = prop_l.is_true();
+  Ci.const_false_prop = prop_l.is_false();
+
+  // 1 - in the transition relation, 2 - in the output function
+  CCUBE Marks(out_var,0);
+
+  for (size_t i=0; i < Next_lits.size(); i++)
+    Ci.mark_cone(Marks,next_var0+i,1);
+  Ci.mark_cone(Marks,out_var,2);
+
+  CUBE Constr_nodes;
+  form_direct_constr_nodes(Constr_nodes);
+  for (size_t i=0; i < Constr_nodes.size(); i++)
+    Ci.mark_cone(Marks,Constr_nodes[i]+1,3);
+
+  Ci.num_gates = 0;
+  for (int var=1; var <= out_var; var++) {
+    char mark = Marks[var-1];
+    if (mark == 0) continue;
+    CNF H;
+    if (var == 1) {
+      CLAUSE U;
+      U.push_back(-1);
+      H.push_back(U);
+    }
+    else if (Ci.Fanin0[var-1] == 0) continue; // an input or a latch
+    else {
+      Ci.add_gate_clauses(H,var);
+      Ci.num_gates++;
+    }
+
+    if (mark & 1) add_dnf(Ci.Tr,H);
+    if (mark & 2) {
+      add_dnf(Ci.Prop,H);
+      if ((mark & 1) == 0) add_dnf(Ci.Short_prop,H);
+    }
+  }
+
+  CLAUSE U;
+  U.push_back(out_var);
+  Ci.Prop.push_back(U);
+  Ci.Short_prop.push_back(U);
+
+  for (size_t i=0; i < Latch_lits.size(); i++) {
+    int var = conv_lit(Latch_lits[i]);
+    CLAUSE U;
+    switch (Latch_val[Latch_lits[i].var_no()]) {
+    case 0: U.push_back(-var); break;
+    case 1: U.push_back(var); break;
+    case 2: break;
+    default: assert(false);
+    }
+    if (U.size() > 0) Ci.Ist.push_back(U);
+  }
+
+  Ci.form_var_nums();
+
+  // variable tables
+  SCUBE Latch_vars;
+  CUBE Pairs0,Pairs1;
+  for (size_t i=0; i < Latch_lits.size(); i++) {
+    int var = conv_lit(Latch_lits[i]);
+    int next_var = next_var0+i;
+    Latch_vars.insert(var);
+    Ci.Pres_svars.push_back(var);
+    Ci.Next_svars.push_back(next_var);
+    Pairs0.push_back(var);
+    Pairs0.push_back(next_var);
+    Pairs1.push_back(next_var);
+    Pairs1.push_back(var);
+  }
+  form_table(Ci.Pres_to_next,Pairs0,Ci.max_num_vars);
+  form_table(Ci.Next_to_pres,Pairs1,Ci.max_num_vars);
+
+  // unused inputs are not in the formulas
+  for (size_t i=1; i < Nodes.size(); i++) {
+    if (!Nodes[i].is_var()) continue;
+    if (Marks[i] == 0) continue;
+    if (Latch_vars.find(i+1) != Latch_vars.end()) continue;
+    Ci.Inp_vars.push_back(i+1);
+  }
+
+  Ci.form_max_pres_svar();
+
+  form_direct_constr_lits(Latch_vars);
+  Ci.add_constrs();
+
+} /* end of function read_netlist_direct */
+
+/*==================================================
+
+  F O R M _ D I R E C T _ C O N S T R _ N O D E S
+
+  Collects the nodes whose literals are
+  constrained. Their cones are added both to the
+  transition relation and to the output function
+
+  =================================================*/
+void ic3_enginet::form_direct_constr_nodes(CUBE &Constr_nodes)
+{
+
+  aigt::nodest &Nodes = netlist.nodes;
+
+  SCUBE::iterator pnt;
+  for (pnt = Ci.Init_clits.begin(); pnt != Ci.Init_clits.end(); pnt++) {
+    size_t node_ind = (*pnt) >> 1;
+    if (node_ind == 0) continue;
+    assert(node_ind < Nodes.size());
+    Constr_nodes.push_back(node_ind);
+  }
+
+} /* end of function form_direct_constr_nodes */
+
+/*==================================================
+
+  F O R M _ D I R E C T _ C O N S T R _ L I T S
+
+  Does what 'form_constr_lits' does for circuit N
+
+  =================================================*/
+void ic3_enginet::form_direct_constr_lits(SCUBE &Latch_vars)
+{
+
+  aigt::nodest &Nodes = netlist.nodes;
+
+  SCUBE::iterator pnt;
+  for (pnt = Ci.Init_clits.begin(); pnt != Ci.Init_clits.end(); pnt++) {
+    size_t node_ind = (*pnt) >> 1;
+    if (node_ind == 0) continue;
+    int var = node_ind+1;
+    int lit = ((*pnt) & 1) ? -var : var;
+
+    if (Nodes[node_ind].is_and()) {
+      Ci.Constr_nilits.insert(lit);
+      Ci.Fun_coi_lits.push_back(lit);
+      Ci.Tr_coi_lits.push_back(lit);
+      continue;
+    }
+
+    if (Latch_vars.find(var) == Latch_vars.end()) {
+      Ci.Constr_ilits.push_back(lit);
+      Ci.Constr_inp_lits.insert(lit);
+      continue;
+    }
+
+    Ci.Constr_ps_lits.insert(lit);
+    Ci.Constr_ilits.push_back(lit);
+    int nxt_var_ind = Ci.Pres_to_next[var-1];
+    if (lit < 0) Ci.Constr_nilits.insert(-(nxt_var_ind+1));
+    else Ci.Constr_nilits.insert(nxt_var_ind+1);
+  }
+
+} /* end of function form_direct_constr_lits */
+
+/*==============================
+
+     M A R K _ C O N E
+
+  Sets 'flag' in the marks of the
+  variables of the cone of 'var'
+  stopping at inputs and latches
+
+  ==============================*/
+void CompInfo::mark_cone(CCUBE &Marks,int var,char flag)
+{
+
+  CUBE Stack;
+  Stack.push_back(var);
+
+  while (Stack.size() > 0) {
+    int var1 = Stack.back();
+    Stack.pop_back();
+    if ((Marks[var1-1] & flag) == flag) continue;
+    Marks[var1-1] |= flag;
+    if (Fanin0[var1-1] == 0) continue;
+    Stack.push_back(abs(Fanin0[var1-1]));
+    Stack.push_back(abs(Fanin1[var1-1]));
+  }
+
+} /* end of function mark_cone */
+
+/*=====================================
+
+    A D D _ G A T E _ C L A U S E S
+
+  =====================================*/
+void CompInfo::add_gate_clauses(CNF &H,int var)
+{
+
+  int lit0 = Fanin0[var-1];
+  int lit1 = Fanin1[var-1];
+  CLAUSE C;
+
+  if (lit0 == lit1) { // a buffer
+    C.push_back(lit0);
+    C.push_back(-var);
+    H.push_back(C);
+    C.clear();
+    C.push_back(-lit0);
+    C.push_back(var);
+    H.push_back(C);
+    return;
+  }
+
+  // long clause
+  if (lit0 != -lit1) {
+    C.push_back(-lit0);
+    C.push_back(-lit1);
+    C.push_back(var);
+    H.push_back(C);
+  }
+
+  // short clauses
+  C.clear();
+  C.push_back(lit0);
+  C.push_back(-var);
+  H.push_back(C);
+  C.clear();
+  C.push_back(lit1);
+  C.push_back(-var);
+  H.push_back(C);
+
+} /* end of function add_gate_clauses */
@@ -28,8 +28,12 @@ void CompInfo::print_stat()
 
   printf("num of time frames = %d\n",max_num_tfs);
   if (inv_ind >= 0)   printf("inv_ind = %d\n",inv_ind);
-  my_printf("#inputs = %m, #outputs = %m, #latches = %m, #gates = %m\n",
-	    N->ninputs,N->noutputs,N->nlatches, N->ngates);
+  if (N == NULL)
+    my_printf("#inputs = %m, #outputs = %m, #latches = %m, #gates = %m\n",
+              (int) Inp_vars.size(),1,(int) Pres_svars.size(),num_gates);
+  else
+    my_printf("#inputs = %m, #outputs = %m, #latches = %m, #gates = %m\n",
+              N->ninputs,N->noutputs,N->nlatches, N->ngates);
   printf("total number of generated clauses is %d\n",(int) F.size()- 
          (int) Ist.size() + init_ind_cls());
 
@@ -59,6 +63,9 @@ void CompInfo::print_stat()
 
  
   my_printf("#CTGs = %m, #excluded CTGS = %m\n",tot_ctg_cnt,succ_ctg_cnt);
+  if (num_workers > 1)
+    my_printf("#shared clauses = %m, #imported clauses = %m\n",
+              num_shared_lemmas,num_imported_lemmas);
 } /* end of function print_stat */
 
 
@@ -179,6 +186,7 @@ void CompInfo::print_time_frame_sat_stat(int &time_frame_calls)
 
   my_printf("Time frame SAT-solvers: %m calls\n",time_frame_calls); 
   my_printf("Push clause SAT-solving: %m calls\n",num_push_clause_calls);
+  my_printf("Push clause SAT-solving: %m calls saved\n",num_saved_push_calls);
 
 } /* end of function print_time_frame_sat_stat */
 
@@ -32,6 +32,9 @@ void CompInfo::print_lifting_stat()
   float av_gc_size = length_gstate_cubes / num_gstate_cubes;
   printf("#svars = %d, aver. bst. cube = %.1f, aver. gst. cube = %.1f\n",
 	 (int) Pres_svars.size(),av_bc_size,av_gc_size);
+  if (tern_lift_flag)
+    my_printf("#ternary lifts = %m, #SAT fallbacks = %m\n",num_tern_lifts,
+              num_tern_fallbacks);
  
 
 } /* end of function print_lifting_stat */
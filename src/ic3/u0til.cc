@@ -46,6 +46,7 @@ void CompInfo::accept_new_clause(SatSolver &Slvr,CLAUSE &C)
   TrivMclause A;
   conv_to_mclause(A,C);
   Slvr.Mst->addClause(A);
+  Slvr.last_change = ++clause_stamp;
 
 
 }  /* end of function accept_new_clause */
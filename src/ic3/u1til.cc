@@ -47,6 +47,10 @@ void CompInfo::add_fclause1(CLAUSE &C,int last_ind,char st_descr)
     goto NEXT;
   }
 
+  if (rem_subsumed_flag && subsumed_by_fclause(C,last_ind)) {
+    if (st_descr <= CTG_STATE) Time_frames[tf_lind].num_redund_cls++;
+    return;
+  }
  
   assert((last_ind >= 0) && ((size_t) last_ind < Time_frames.size()));
   Time_frames[last_ind].num_bnd_cls++;
@@ -55,6 +59,9 @@ void CompInfo::add_fclause1(CLAUSE &C,int last_ind,char st_descr)
   el.span = last_ind;
   el.active = 1;
   el.skip = 0;
+  el.sig = clause_sig(C);
+  el.push_tf = -1;
+  el.push_stamp = 0;
 
   Clause_info.push_back(el);
   
@@ -64,6 +71,7 @@ void CompInfo::add_fclause1(CLAUSE &C,int last_ind,char st_descr)
 
 
   F.push_back(C);
+  add_to_lit_arrays(clause_ind);
   
 
  
@@ -82,6 +90,10 @@ void CompInfo::add_fclause1(CLAUSE &C,int last_ind,char st_descr)
     Time_frames[i].Clauses.push_back(clause_ind);
   }
 
+  if (rem_subsumed_flag) rem_subsumed_clauses(clause_ind);
+
+  if ((Lex != NULL) && (st_descr != SHARED_STATE)) share_lemma(C,last_ind);
+
 } /* end of function add_fclause1 */
 
 
@@ -42,18 +42,24 @@ void CompInfo::add_fclause2(CLAUSE &C,int last_ind,bool upd_activity)
   el.span = last_ind;
   el.active = 1;
   el.skip = 0;
+  el.sig = clause_sig(C);
+  el.push_tf = -1;
+  el.push_stamp = 0;
 
   Clause_info.push_back(el);
   
   Clause_table[C] = F.size();
 
   F.push_back(C);
+  add_to_lit_arrays(clause_ind);
 
   for (int i=1; i <= last_ind; i++) 
     Time_frames[i].Clauses.push_back(clause_ind);
   
   if (upd_activity) upd_act_lit_cnts(C,last_ind);
 
+  if (rem_subsumed_flag && (last_ind > 0)) rem_subsumed_clauses(clause_ind);
+
 } /* end of function add_fclause2 */
 
 /*=======================
@@ -87,10 +93,32 @@ void CompInfo::clean_clause_set()
   clean_formula();
   recomp_tf_cls_sets();
   build_new_clause_table();
+  form_lit_arrays();
+  rebuild_tf_solvers();
   num_inact_cls = 0;
 
 } /* end of function clean_clause_set */
 
+/*===================================
+
+    R E B U I L D _ T F _ S O L V E R S
+
+  The SAT-solvers of time frames still
+  contain the removed clauses. They are
+  generated anew from F
+
+  ====================================*/
+void CompInfo::rebuild_tf_solvers()
+{
+
+  for (size_t i=1; i < Time_frames.size(); i++) {
+    delete_solver(Time_frames[i].Slvr);
+    init_time_frame_solver(i);
+    add_new_clauses(Time_frames[i].Slvr,Time_frames[i].Clauses);
+  }
+
+} /* end of function rebuild_tf_solvers */
+
 /*============================================
 
   B U I L D _ N E W _ C L A U S E _ T A B L E 
@@ -31,6 +31,7 @@ void bmc_mapt::map_timeframes(
 {
   var_map=netlist.var_map;
   timeframe_map.resize(no_timeframes);
+  memory_reads.resize(netlist.memories.size());
   
   for(unsigned t=0; t<timeframe_map.size(); t++)
   {
@@ -80,6 +80,17 @@ public:
 
   typedef std::map<literalt, reverse_entryt> reverse_mapt;
   reverse_mapt reverse_map;
+
+  // the reads of each memory unwound so far, as solver literals;
+  // 'initial' holds if the read returns the initial contents
+  struct memory_readt
+  {
+    bvt address, data;
+    literalt initial;
+  };
+
+  typedef std::vector<memory_readt> memory_readst;
+  std::vector<memory_readst> memory_reads;
   
   unsigned get_no_timeframes() const
   {
@@ -96,6 +107,7 @@ public:
   {
     timeframe_map.clear();
     reverse_map.clear();
+    memory_reads.clear();
   }
 };
 
@@ -45,12 +45,43 @@ public:
     other.var_map.swap(var_map);
     initial.swap(other.initial);
     transition.swap(other.transition);
+    memories.swap(other.memories);
   }
   
   // additional constraints, given as netlist literals
   // these are implicit conjunctions
   bvt initial;
   bvt transition;
+
+  // Memories that are not bit-blasted. Their contents are not
+  // latches; instead, the unwinding relates the data of each
+  // read port to the write ports of the earlier timeframes.
+  struct memoryt
+  {
+    irep_idt identifier;
+
+    struct read_portt
+    {
+      bvt address, data;
+    };
+
+    struct write_portt
+    {
+      literalt enable;
+      bvt address, data;
+    };
+
+    typedef std::vector<read_portt> read_portst;
+    typedef std::vector<write_portt> write_portst;
+
+    read_portst read_ports;
+
+    // a later write port takes precedence over an earlier one
+    write_portst write_ports;
+  };
+
+  typedef std::vector<memoryt> memoriest;
+  memoriest memories;
   
 protected:
   static std::string id2smv(const irep_idt &id);
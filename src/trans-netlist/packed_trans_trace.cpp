@@ -0,0 +1,200 @@
+/*******************************************************************\
+
+Module: Packed Counterexamples
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+#include <cassert>
+
+#include <util/std_expr.h>
+
+#include "packed_trans_trace.h"
+#include "trans_trace_netlist.h"
+
+/*******************************************************************\
+
+Function: packed_trans_tracet::get_bit
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+tvt packed_trans_tracet::get_bit(
+  const signalt &signal,
+  unsigned t,
+  std::size_t bit_nr) const
+{
+  assert(t<get_no_timeframes());
+  assert(bit_nr<signal.width);
+
+  const wordt bit=wordt(1)<<(bit_nr%word_bits);
+  const std::size_t word_nr=bit_nr/word_bits;
+
+  const wordt *u=unknown_words(signal, t);
+
+  if(u!=nullptr && (u[word_nr]&bit)!=0)
+    return tvt::unknown();
+
+  return tvt((value_words(signal, t)[word_nr]&bit)!=0);
+}
+
+/*******************************************************************\
+
+Function: packed_trans_tracet::get_bitstring
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+std::string packed_trans_tracet::get_bitstring(
+  const signalt &signal,
+  unsigned t) const
+{
+  assert(t<get_no_timeframes());
+
+  const wordt *v=value_words(signal, t);
+  const wordt *u=unknown_words(signal, t);
+
+  std::string result;
+  result.reserve(signal.width);
+
+  for(std::size_t i=signal.width; i!=0; i--)
+  {
+    const std::size_t bit_nr=i-1;
+    const wordt bit=wordt(1)<<(bit_nr%word_bits);
+
+    if(u!=nullptr && (u[bit_nr/word_bits]&bit)!=0)
+      result+='?';
+    else if((v[bit_nr/word_bits]&bit)!=0)
+      result+='1';
+    else
+      result+='0';
+  }
+
+  return result;
+}
+
+/*******************************************************************\
+
+Function: packed_trans_tracet::get_value
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+exprt packed_trans_tracet::get_value(
+  const signalt &signal,
+  unsigned t) const
+{
+  return bitstring_to_expr(get_bitstring(signal, t), signal.type);
+}
+
+/*******************************************************************\
+
+Function: packed_trans_tracet::get_max_failing_timeframe
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+unsigned packed_trans_tracet::get_max_failing_timeframe() const
+{
+  unsigned max=0;
+
+  for(unsigned t=0; t<property_failed.size(); t++)
+  {
+    if(property_failed[t])
+      max=t;
+  }
+
+  return max;
+}
+
+/*******************************************************************\
+
+Function: packed_trans_tracet::get_min_failing_timeframe
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+unsigned packed_trans_tracet::get_min_failing_timeframe() const
+{
+  for(unsigned t=0; t<property_failed.size(); t++)
+    if(property_failed[t])
+      return t;
+
+  return 0;
+}
+
+/*******************************************************************\
+
+Function: packed_trans_tracet::materialise
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void packed_trans_tracet::materialise(
+  const namespacet &ns,
+  trans_tracet &dest,
+  std::size_t no_timeframes) const
+{
+  assert(no_timeframes<=get_no_timeframes());
+
+  dest.mode=mode;
+  dest.states.clear();
+  dest.states.resize(no_timeframes);
+
+  // the symbols are the same in every timeframe
+  std::vector<symbol_exprt> lhs;
+  lhs.reserve(signals.size());
+
+  for(const auto &signal : signals)
+    lhs.push_back(ns.lookup(signal.identifier).symbol_expr());
+
+  for(unsigned t=0; t<no_timeframes; t++)
+  {
+    trans_tracet::statet &state=dest.states[t];
+
+    for(std::size_t i=0; i<signals.size(); i++)
+    {
+      state.assignments.push_back(trans_tracet::statet::assignmentt());
+
+      trans_tracet::statet::assignmentt &assignment=
+        state.assignments.back();
+
+      assignment.lhs=lhs[i];
+      assignment.rhs=get_value(signals[i], t);
+      assignment.location.make_nil();
+    }
+
+    state.property_failed=property_failed[t];
+  }
+}
@@ -0,0 +1,126 @@
+/*******************************************************************\
+
+Module: Packed Counterexamples
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+#ifndef CPROVER_TRANS_PACKED_TRANS_TRACE_H
+#define CPROVER_TRANS_PACKED_TRANS_TRACE_H
+
+#include <cstdint>
+
+#include "trans_trace.h"
+
+// A trace stored by column: for every variable, the bits of all
+// timeframes are kept as packed words. Variables that have bits
+// without a value in some timeframe additionally get a column of
+// 'unknown' words. Expressions are only built on demand.
+
+class packed_trans_tracet
+{
+public:
+  typedef std::uint64_t wordt;
+
+  static const std::size_t word_bits=64;
+
+  static std::size_t words(std::size_t width)
+  {
+    return (width+word_bits-1)/word_bits;
+  }
+
+  struct signalt
+  {
+    irep_idt identifier;
+    typet type;
+    std::size_t width;
+
+    // timeframe t starts at offset+t*words(width)
+    std::size_t value_offset;
+    std::size_t unknown_offset;
+
+    bool has_unknown() const
+    {
+      return unknown_offset!=no_offset;
+    }
+
+    static const std::size_t no_offset=~std::size_t(0);
+  };
+
+  typedef std::vector<signalt> signalst;
+  signalst signals;
+
+  std::vector<wordt> values, unknowns;
+
+  // one entry per timeframe
+  std::vector<bool> property_failed;
+
+  // mode of whole trace
+  std::string mode;
+
+  std::size_t get_no_timeframes() const
+  {
+    return property_failed.size();
+  }
+
+  bool empty() const
+  {
+    return property_failed.empty();
+  }
+
+  void clear()
+  {
+    signals.clear();
+    values.clear();
+    unknowns.clear();
+    property_failed.clear();
+    mode.clear();
+  }
+
+  const wordt *value_words(const signalt &signal, unsigned t) const
+  {
+    return values.data()+signal.value_offset+t*words(signal.width);
+  }
+
+  // returns nullptr if all bits of the signal are known
+  const wordt *unknown_words(const signalt &signal, unsigned t) const
+  {
+    if(!signal.has_unknown())
+      return nullptr;
+    return unknowns.data()+signal.unknown_offset+t*words(signal.width);
+  }
+
+  tvt get_bit(const signalt &, unsigned t, std::size_t bit_nr) const;
+
+  // most significant bit first, '?' for bits without value
+  std::string get_bitstring(const signalt &, unsigned t) const;
+
+  exprt get_value(const signalt &, unsigned t) const;
+
+  // returns the latest failing timeframe
+  unsigned get_max_failing_timeframe() const;
+
+  // returns the earliest failing timeframe
+  unsigned get_min_failing_timeframe() const;
+
+  // build the expression-based trace for the
+  // first 'no_timeframes' timeframes
+  void materialise(
+    const namespacet &,
+    trans_tracet &dest,
+    std::size_t no_timeframes) const;
+
+  void materialise(const namespacet &ns, trans_tracet &dest) const
+  {
+    materialise(ns, dest, get_no_timeframes());
+  }
+};
+
+void show_trans_trace_vcd(
+  const packed_trans_tracet &trace,
+  messaget &message,
+  const namespacet &ns,
+  std::ostream &out);
+
+#endif
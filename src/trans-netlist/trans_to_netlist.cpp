@@ -6,7 +6,10 @@ Author: Daniel Kroening, kroening@kroening.com
 
 \*******************************************************************/
 
+#include <algorithm>
+
 #include <util/arith_tools.h>
+#include <util/bitvector_types.h>
 #include <util/ebmc_util.h>
 #include <util/namespace.h>
 #include <util/std_expr.h>
@@ -32,11 +35,13 @@ public:
   convert_trans_to_netlistt(
     symbol_tablet &_symbol_table,
     netlistt &_dest,
+    const std::set<irep_idt> &_memories,
     message_handlert &_message_handler):
     messaget(_message_handler),
     symbol_table(_symbol_table),
     ns(_symbol_table),
-    dest(_dest)
+    dest(_dest),
+    memories(_memories)
   {
   }
 
@@ -46,9 +51,45 @@ protected:
   symbol_tablet &symbol_table;
   const namespacet ns;
   netlistt &dest;
+
+  // the memories that are not to be bit-blasted,
+  // mapped to their index in dest.memories
+  std::set<irep_idt> memories;
+  std::map<irep_idt, std::size_t> memory_map;
   
   literalt new_input();
 
+  // the ports are converted once all wires are known
+  struct memory_portt
+  {
+    std::size_t memory;
+    exprt enable, address;
+    exprt data; // write ports only
+  };
+
+  typedef std::list<memory_portt> memory_portst;
+  memory_portst read_ports, write_ports;
+
+  // identical reads share their port
+  std::map<exprt, symbol_exprt> read_port_map;
+
+  void select_memories(const transt &trans);
+  void check_memory_use(const exprt &expr);
+  void remove_memories(const exprt &expr);
+  void check_memory_constraint(
+    const exprt &expr,
+    std::map<irep_idt, unsigned> &);
+  void check_memory_write(const exprt &expr, const irep_idt &memory);
+  void remove_memory(const irep_idt &memory);
+
+  void replace_memory_reads(exprt &expr);
+  void replace_memory_constraint(exprt &expr);
+  void add_memory_writes(
+    const exprt &expr,
+    const exprt &guard,
+    std::size_t memory);
+  void convert_memory_ports(propt &prop);
+
   class rhs_entryt
   {
   public:
@@ -187,11 +228,13 @@ void convert_trans_to_netlistt::map_vars(
 {
   boolbv_widtht boolbv_width(ns);
 
-  auto update_dest_var_map = [&dest, &boolbv_width](const symbolt &symbol) {
+  auto update_dest_var_map = [this, &dest, &boolbv_width](const symbolt &symbol) {
     var_mapt::vart::vartypet vartype;
 
     if (symbol.is_property)
       return; // ignore properties
+    else if (memories.find(symbol.name) != memories.end())
+      return; // these are not bit-blasted
     else if (symbol.type.id() == ID_module ||
              symbol.type.id() == ID_module_instance)
       return; // ignore modules
@@ -245,8 +288,27 @@ void convert_trans_to_netlistt::operator()(const irep_idt &module)
   lhs_map.clear();
   rhs_list.clear();
   constraint_list.clear();
+  read_ports.clear();
+  write_ports.clear();
+  read_port_map.clear();
+
+  const symbolt &module_symbol=ns.lookup(module);
+  const transt &trans=to_trans_expr(module_symbol.value);
+
+  select_memories(trans);
   
   map_vars(module, dest);
+
+  // the reads of the memories become variables of their own,
+  // the next-state functions become write ports
+  exprt invar=trans.invar();
+  exprt trans_constraint=trans.trans();
+
+  if(!memories.empty())
+  {
+    replace_memory_constraint(invar);
+    replace_memory_constraint(trans_constraint);
+  }
   
   // setup lhs_map
 
@@ -270,15 +332,12 @@ void convert_trans_to_netlistt::operator()(const irep_idt &module)
     }
   }
 
-  const symbolt &module_symbol=ns.lookup(module);
-  const transt &trans=to_trans_expr(module_symbol.value);
-
   // build the net-list
   aig_prop_constraintt aig_prop(dest, get_message_handler());
 
   // extract constraints from transition relation
-  add_constraint(trans.invar());
-  add_constraint(trans.trans());
+  add_constraint(invar);
+  add_constraint(trans_constraint);
 
   // do recursive conversion for LHSs
   for(lhs_mapt::iterator
@@ -292,6 +351,8 @@ void convert_trans_to_netlistt::operator()(const irep_idt &module)
 
   // do the remaining transition constraints
   convert_constraints(aig_prop);
+
+  convert_memory_ports(aig_prop);
   
   dest.transition.insert(
     dest.transition.end(),
@@ -327,6 +388,443 @@ void convert_trans_to_netlistt::operator()(const irep_idt &module)
 
 /*******************************************************************\
 
+Function: convert_trans_to_netlistt::remove_memory
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: the memory is used in a way that the ports cannot
+          express; it is bit-blasted instead
+
+\*******************************************************************/
+
+void convert_trans_to_netlistt::remove_memory(const irep_idt &memory)
+{
+  if(memories.erase(memory)!=0)
+    warning() << "memory `" << memory << "' is bit-blasted" << eom;
+}
+
+/*******************************************************************\
+
+Function: convert_trans_to_netlistt::check_memory_use
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: reading with an index is the only permitted use
+
+\*******************************************************************/
+
+void convert_trans_to_netlistt::check_memory_use(const exprt &expr)
+{
+  if(expr.id()==ID_index &&
+     expr.operands().size()==2 &&
+     expr.op0().id()==ID_symbol &&
+     memories.find(expr.op0().get(ID_identifier))!=memories.end())
+  {
+    check_memory_use(expr.op1());
+  }
+  else if(expr.id()==ID_symbol || expr.id()==ID_next_symbol)
+    remove_memory(expr.get(ID_identifier));
+  else
+  {
+    forall_operands(it, expr)
+      check_memory_use(*it);
+  }
+}
+
+/*******************************************************************\
+
+Function: convert_trans_to_netlistt::remove_memories
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: bit-blast all memories that the expression refers to
+
+\*******************************************************************/
+
+void convert_trans_to_netlistt::remove_memories(const exprt &expr)
+{
+  if(expr.id()==ID_symbol || expr.id()==ID_next_symbol)
+    remove_memory(expr.get(ID_identifier));
+  else
+  {
+    forall_operands(it, expr)
+      remove_memories(*it);
+  }
+}
+
+/*******************************************************************\
+
+Function: convert_trans_to_netlistt::check_memory_write
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: the next-state function must be built from the memory,
+          'with' and 'if'
+
+\*******************************************************************/
+
+void convert_trans_to_netlistt::check_memory_write(
+  const exprt &expr,
+  const irep_idt &memory)
+{
+  if(expr.id()==ID_symbol && expr.get(ID_identifier)==memory)
+  {
+  }
+  else if(expr.id()==ID_with && expr.operands().size()%2==1)
+  {
+    check_memory_write(expr.op0(), memory);
+
+    for(std::size_t i=1; i<expr.operands().size(); i++)
+      check_memory_use(expr.operands()[i]);
+  }
+  else if(expr.id()==ID_if && expr.operands().size()==3)
+  {
+    check_memory_use(expr.op0());
+    check_memory_write(expr.op1(), memory);
+    check_memory_write(expr.op2(), memory);
+  }
+  else
+  {
+    remove_memory(memory);
+    check_memory_use(expr);
+  }
+}
+
+/*******************************************************************\
+
+Function: convert_trans_to_netlistt::check_memory_constraint
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void convert_trans_to_netlistt::check_memory_constraint(
+  const exprt &expr,
+  std::map<irep_idt, unsigned> &next_state_count)
+{
+  if(expr.id()==ID_and)
+  {
+    forall_operands(it, expr)
+      check_memory_constraint(*it, next_state_count);
+  }
+  else if(expr.id()==ID_equal &&
+          expr.operands().size()==2 &&
+          expr.op0().id()==ID_next_symbol &&
+          memories.find(expr.op0().get(ID_identifier))!=memories.end())
+  {
+    const irep_idt &memory=expr.op0().get(ID_identifier);
+    next_state_count[memory]++;
+    check_memory_write(expr.op1(), memory);
+  }
+  else
+    check_memory_use(expr);
+}
+
+/*******************************************************************\
+
+Function: convert_trans_to_netlistt::select_memories
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: keep the memories that are state variables, have no
+          initial value, and are only read with an index and
+          written by a single next-state function
+
+\*******************************************************************/
+
+void convert_trans_to_netlistt::select_memories(const transt &trans)
+{
+  memory_map.clear();
+
+  if(memories.empty())
+    return;
+
+  boolbv_widtht boolbv_width(ns);
+
+  for(std::set<irep_idt>::iterator
+      it=memories.begin();
+      it!=memories.end();
+      ) // no it++
+  {
+    const symbolt *symbol;
+
+    if(ns.lookup(*it, symbol) ||
+       !symbol->is_state_var ||
+       symbol->type.id()!=ID_array ||
+       boolbv_width(symbol->type.subtype())==0)
+      it=memories.erase(it);
+    else
+      it++;
+  }
+
+  std::map<irep_idt, unsigned> next_state_count;
+
+  // the initial contents are arbitrary
+  remove_memories(trans.init());
+
+  check_memory_constraint(trans.invar(), next_state_count);
+  check_memory_constraint(trans.trans(), next_state_count);
+
+  for(const auto &count : next_state_count)
+    if(count.second>1)
+      remove_memory(count.first);
+
+  for(const auto &memory : memories)
+  {
+    memory_map[memory]=dest.memories.size();
+    dest.memories.push_back(netlistt::memoryt());
+    dest.memories.back().identifier=memory;
+  }
+
+  if(!memories.empty())
+    statistics() << "Memories not bit-blasted: " << memories.size() << eom;
+}
+
+/*******************************************************************\
+
+Function: convert_trans_to_netlistt::replace_memory_reads
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: replace each read by the data of a new read port
+
+\*******************************************************************/
+
+void convert_trans_to_netlistt::replace_memory_reads(exprt &expr)
+{
+  Forall_operands(it, expr)
+    replace_memory_reads(*it);
+
+  if(expr.id()!=ID_index ||
+     expr.operands().size()!=2 ||
+     expr.op0().id()!=ID_symbol)
+    return;
+
+  std::map<irep_idt, std::size_t>::const_iterator m_it=
+    memory_map.find(expr.op0().get(ID_identifier));
+
+  if(m_it==memory_map.end())
+    return;
+
+  std::map<exprt, symbol_exprt>::const_iterator r_it=
+    read_port_map.find(expr);
+
+  if(r_it!=read_port_map.end())
+  {
+    expr=r_it->second;
+    return;
+  }
+
+  netlistt::memoryt &memory=dest.memories[m_it->second];
+
+  const irep_idt identifier=
+    "convert::read::"+id2string(memory.identifier)+"::"+
+    std::to_string(memory.read_ports.size());
+
+  memory.read_ports.push_back(netlistt::memoryt::read_portt());
+  netlistt::memoryt::read_portt &read_port=memory.read_ports.back();
+
+  // the data of the read is free in every timeframe,
+  // the unwinding constrains it
+  boolbv_widtht boolbv_width(ns);
+  std::size_t width=boolbv_width(expr.type());
+
+  var_mapt::vart &var=dest.var_map.map[identifier];
+  var.vartype=var_mapt::vart::vartypet::NONDET;
+  var.type=expr.type();
+  var.bits.resize(width);
+
+  for(std::size_t bit_nr=0; bit_nr<width; bit_nr++)
+  {
+    literalt l=dest.new_var_node();
+    var.bits[bit_nr].current=l;
+    var.bits[bit_nr].next=const_literal(false); // just to fill it
+    read_port.data.push_back(l);
+
+    bv_varidt &reverse=dest.var_map.reverse_map[l.var_no()];
+    reverse.id=identifier;
+    reverse.bit_nr=bit_nr;
+  }
+
+  memory_portt port;
+  port.memory=m_it->second;
+  port.address=expr.op1();
+  read_ports.push_back(port);
+
+  symbol_exprt data(identifier, expr.type());
+  read_port_map.insert(std::make_pair(expr, data));
+  expr=data;
+}
+
+/*******************************************************************\
+
+Function: convert_trans_to_netlistt::add_memory_writes
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void convert_trans_to_netlistt::add_memory_writes(
+  const exprt &expr,
+  const exprt &guard,
+  std::size_t memory)
+{
+  if(expr.id()==ID_symbol)
+  {
+    // unchanged
+  }
+  else if(expr.id()==ID_with)
+  {
+    // the base first, as the later updates take precedence
+    add_memory_writes(expr.op0(), guard, memory);
+
+    for(std::size_t i=1; i+1<expr.operands().size(); i+=2)
+    {
+      memory_portt port;
+      port.memory=memory;
+      port.enable=guard;
+      port.address=expr.operands()[i];
+      port.data=expr.operands()[i+1];
+      replace_memory_reads(port.address);
+      replace_memory_reads(port.data);
+      write_ports.push_back(port);
+    }
+  }
+  else if(expr.id()==ID_if)
+  {
+    exprt cond=expr.op0();
+    replace_memory_reads(cond);
+
+    add_memory_writes(
+      expr.op1(), and_exprt(guard, cond), memory);
+    add_memory_writes(
+      expr.op2(), and_exprt(guard, not_exprt(cond)), memory);
+  }
+  else
+    assert(false); // excluded by check_memory_write
+}
+
+/*******************************************************************\
+
+Function: convert_trans_to_netlistt::replace_memory_constraint
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void convert_trans_to_netlistt::replace_memory_constraint(exprt &expr)
+{
+  if(expr.id()==ID_and)
+  {
+    Forall_operands(it, expr)
+      replace_memory_constraint(*it);
+  }
+  else if(expr.id()==ID_equal &&
+          expr.operands().size()==2 &&
+          expr.op0().id()==ID_next_symbol &&
+          memory_map.find(expr.op0().get(ID_identifier))!=memory_map.end())
+  {
+    add_memory_writes(
+      expr.op1(), true_exprt(),
+      memory_map[expr.op0().get(ID_identifier)]);
+
+    expr=true_exprt();
+  }
+  else
+    replace_memory_reads(expr);
+}
+
+/*******************************************************************\
+
+Function: convert_trans_to_netlistt::convert_memory_ports
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: all ports of a memory get addresses of the same width
+
+\*******************************************************************/
+
+void convert_trans_to_netlistt::convert_memory_ports(propt &prop)
+{
+  boolbv_widtht boolbv_width(ns);
+
+  std::vector<std::size_t> address_width(dest.memories.size(), 0);
+
+  for(const auto &port : read_ports)
+    address_width[port.memory]=std::max(
+      address_width[port.memory], boolbv_width(port.address.type()));
+
+  for(const auto &port : write_ports)
+    address_width[port.memory]=std::max(
+      address_width[port.memory], boolbv_width(port.address.type()));
+
+  auto convert=[this, &prop](const exprt &expr, bvt &bv)
+  {
+    instantiate_convert(
+      prop, dest.var_map, expr, ns, get_message_handler(), bv);
+  };
+
+  std::vector<std::size_t> read_port_nr(dest.memories.size(), 0);
+
+  for(const auto &port : read_ports)
+  {
+    netlistt::memoryt &memory=dest.memories[port.memory];
+
+    convert(
+      typecast_exprt::conditional_cast(
+        port.address, unsignedbv_typet(address_width[port.memory])),
+      memory.read_ports[read_port_nr[port.memory]++].address);
+  }
+
+  for(const auto &port : write_ports)
+  {
+    netlistt::memoryt &memory=dest.memories[port.memory];
+
+    memory.write_ports.push_back(netlistt::memoryt::write_portt());
+    netlistt::memoryt::write_portt &write_port=memory.write_ports.back();
+
+    bvt enable;
+    convert(port.enable, enable);
+    assert(enable.size()==1);
+    write_port.enable=enable.front();
+
+    convert(
+      typecast_exprt::conditional_cast(
+        port.address, unsignedbv_typet(address_width[port.memory])),
+      write_port.address);
+
+    convert(port.data, write_port.data);
+  }
+}
+
+/*******************************************************************\
+
 Function: convert_trans_to_netlistt::convert_constraints
 
   Inputs:
@@ -722,7 +1220,33 @@ void convert_trans_to_netlist(
   netlistt &dest,
   message_handlert &message_handler)
 {
-  convert_trans_to_netlistt c(symbol_table, dest, message_handler);
+  convert_trans_to_netlistt c(
+    symbol_table, dest, std::set<irep_idt>(), message_handler);
+
+  c(module);
+}
+
+/*******************************************************************\
+
+Function: convert_trans_to_netlist
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: as above, but the given memories are kept as
+          read and write ports where possible
+
+\*******************************************************************/
+
+void convert_trans_to_netlist(
+  symbol_tablet &symbol_table,
+  const irep_idt &module,
+  const std::set<irep_idt> &memories,
+  netlistt &dest,
+  message_handlert &message_handler)
+{
+  convert_trans_to_netlistt c(symbol_table, dest, memories, message_handler);
 
   c(module);
 }
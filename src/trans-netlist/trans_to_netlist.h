@@ -9,6 +9,8 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_TRANS_NETLIST_TRANS_H
 #define CPROVER_TRANS_NETLIST_TRANS_H
 
+#include <set>
+
 #include <util/namespace.h>
 #include <util/message.h>
 #include <util/symbol_table.h>
@@ -20,4 +22,14 @@ void convert_trans_to_netlist(
   class netlistt &dest,
   message_handlert &message_handler);
 
+// The given memories (state variables of array type) are not
+// bit-blasted, but kept as read and write ports in dest.memories.
+// Memories that are used in other ways are bit-blasted.
+void convert_trans_to_netlist(
+  symbol_tablet &symbol_table,
+  const irep_idt &module,
+  const std::set<irep_idt> &memories,
+  class netlistt &dest,
+  message_handlert &message_handler);
+
 #endif
@@ -6,15 +6,18 @@ Author: Daniel Kroening, kroening@kroening.com
 
 \*******************************************************************/
 
+#include <algorithm>
 #include <ctime>
 #include <cassert>
 #include <string>
 #include <iostream>
+#include <unordered_map>
 
 #include <goto-programs/xml_expr.h>
 
 #include <util/ebmc_util.h>
 #include <util/expr_util.h>
+#include <util/json.h>
 #include <util/pointer_offset_size.h>
 #include <util/prefix.h>
 #include <util/std_expr.h>
@@ -24,7 +27,9 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "instantiate_netlist.h"
 #include "../trans-word-level/instantiate_word_level.h"
+#include "packed_trans_trace.h"
 #include "trans_trace.h"
+#include "vcd_writer.h"
 
 /*******************************************************************\
 
@@ -197,6 +202,63 @@ void convert(
 
 /*******************************************************************\
 
+Function: convert
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: The same information as in the XML form.
+
+\*******************************************************************/
+
+void convert(
+  const namespacet &ns,
+  const trans_tracet &trace,
+  json_objectt &dest)
+{
+  unsigned last_time_frame=trace.get_min_failing_timeframe();
+
+  dest["mode"]=json_stringt(trace.mode);
+
+  json_arrayt &json_states=dest["states"].make_array();
+
+  for(unsigned t=0; t<=last_time_frame; t++)
+  {
+    assert(t<trace.states.size());
+
+    json_objectt &json_state=json_states.push_back().make_object();
+    const trans_tracet::statet &state=trace.states[t];
+
+    json_state["timeframe"]=json_numbert(std::to_string(t));
+
+    json_arrayt &json_assignments=json_state["assignments"].make_array();
+
+    for(const auto & a : state.assignments)
+    {
+      json_objectt &json_assignment=
+        json_assignments.push_back().make_object();
+
+      assert(a.lhs.id()==ID_symbol);
+      const symbolt &symbol=ns.lookup(to_symbol_expr(a.lhs));
+
+      std::string value_string=
+        a.rhs.is_nil()?"?":from_expr(ns, symbol.name, a.rhs);
+      std::string type_string=from_type(ns, symbol.name, symbol.type);
+
+      json_assignment["identifier"]=json_stringt(id2string(symbol.name));
+      json_assignment["base_name"]=json_stringt(id2string(symbol.base_name));
+      json_assignment["display_name"]=
+        json_stringt(id2string(symbol.display_name()));
+      json_assignment["value"]=json_stringt(value_string);
+      json_assignment["type"]=json_stringt(type_string);
+      json_assignment["mode"]=json_stringt(id2string(symbol.mode));
+    }
+  }
+}
+
+/*******************************************************************\
+
 Function: show_trans_trace
 
   Inputs:
@@ -233,9 +295,21 @@ void show_trans_trace(
       xml.output(std::cout);
     }
     break;
-    case ui_message_handlert::uit::JSON_UI:
-    default:
-      assert(false);
+
+  case ui_message_handlert::uit::JSON_UI:
+    {
+      json_objectt json;
+
+      convert(ns, trace, json);
+
+      // an element of the array the message handler writes
+      static_cast<ui_message_handlert &>(message.get_message_handler()).
+        get_json_stream().push_back(json);
+    }
+    break;
+
+  default:
+    assert(false);
   }
 }
 
@@ -413,61 +487,48 @@ Function: show_trans_state_vcd
  Outputs:
 
  Purpose: dumps the counterexample state in vcd format to be
-          viewed in modelsim or any other simulator
+          viewed in modelsim or any other simulator; the writer
+          only emits the signals whose value changed
 
 \*******************************************************************/
 
-void show_trans_state_vcd(
+typedef std::unordered_map<irep_idt, vcd_writert::signalt, irep_id_hash>
+  vcd_signal_mapt;
+
+static void show_trans_state_vcd(
   unsigned timeframe,
-  const trans_tracet::statet &previous_state,
-  const trans_tracet::statet &current_state,
+  const trans_tracet::statet &state,
+  const vcd_signal_mapt &signal_map,
   const namespacet &ns,
-  std::ostream &out)
+  vcd_writert &writer)
 {
-  out << "#" << timeframe << '\n';
+  writer.timestamp(timeframe);
 
-  // build map for previous state  
-  std::map<irep_idt, exprt> previous_values;
-
-  for(const auto & a : previous_state.assignments)
-    previous_values[a.lhs.get(ID_identifier)]=a.rhs;
-
-  // now dump current state
-  for(const auto & a : current_state.assignments)
+  for(const auto & a : state.assignments)
   {
     assert(a.lhs.id()==ID_symbol);
 
-    const symbolt &symbol=
-      ns.lookup(to_symbol_expr(a.lhs));
-    
-    if(symbol.is_auxiliary)
-      continue;
-    
-    if(timeframe!=0)
-      if(previous_values[symbol.name]==a.rhs)
-        continue; // value didn't change!
-  
     if(a.rhs.is_nil()) // no value
       continue;
-  
-    std::string display_name=id2string(symbol.display_name());
+
+    vcd_signal_mapt::const_iterator s_it=
+      signal_map.find(to_symbol_expr(a.lhs).get_identifier());
+
+    // auxiliary, or not representable
+    if(s_it==signal_map.end())
+      continue;
 
     if(a.lhs.type().id()==ID_bool)
     {
-      // booleans are special -- no space!
-
       if(a.rhs.is_true())
-        out << '1' << vcd_identifier(display_name) << '\n';
+        writer.change(s_it->second, "1");
       else if(a.rhs.is_false())
-        out << '0' << vcd_identifier(display_name) << '\n';
+        writer.change(s_it->second, "0");
       else
-        out << 'x' << vcd_identifier(display_name) << '\n';
+        writer.change(s_it->second, "x");
     }
     else
-    {
-      out << 'b' << as_vcd_binary(a.rhs, ns) << ' '
-          << vcd_identifier(display_name) << '\n';
-    }
+      writer.change(s_it->second, as_vcd_binary(a.rhs, ns));
   }
 }
 
@@ -555,8 +616,9 @@ Function: vcd_hierarchy_rec
 void vcd_hierarchy_rec(
   const namespacet &ns,
   const std::set<irep_idt> &ids,
+  const vcd_signal_mapt &signal_map,
   const std::string &prefix,
-  std::ostream &out,
+  vcd_writert &writer,
   unsigned depth)
 {
   std::set<std::string> sub_modules;
@@ -581,7 +643,8 @@ void vcd_hierarchy_rec(
   {
     const symbolt &symbol=ns.lookup(it);
     
-    if(symbol.is_auxiliary) continue;
+    vcd_signal_mapt::const_iterator s_it=signal_map.find(it);
+    if(s_it==signal_map.end()) continue;
 
     std::string display_name = id2string(symbol.display_name());
     
@@ -594,36 +657,121 @@ void vcd_hierarchy_rec(
     else
       signal_class="wire";
 
-    mp_integer width=vcd_width(symbol.type, ns);
-    
     std::string suffix=vcd_suffix(symbol.type, ns);
     
-    if(width>=1)
-      out << std::string(depth*2, ' ')
-          << "$var " << signal_class << " "
-          << width << " "
-          << vcd_identifier(display_name) << " " 
-          << vcd_identifier(display_name)
-          << (suffix==""?"":" ") << suffix
-          << " $end" << '\n';
+    writer.write(
+      std::string(depth*2, ' ')+
+      "$var "+signal_class+" "+
+      std::to_string(writer.width(s_it->second))+" "+
+      writer.id_code(s_it->second)+" "+
+      vcd_identifier(display_name)+
+      (suffix==""?"":" ")+suffix+
+      " $end\n");
   }
   
   // now do sub modules
   for(const auto & identifier : sub_modules)
   {
-    out << std::string(depth*2, ' ')
-        << "$scope module " << identifier << " $end\n";
+    writer.write(
+      std::string(depth*2, ' ')+"$scope module "+identifier+" $end\n");
 
     // recursive call
-    vcd_hierarchy_rec(ns, ids, prefix+identifier+".", out, depth+1);
+    vcd_hierarchy_rec(
+      ns, ids, signal_map, prefix+identifier+".", writer, depth+1);
     
-    out << std::string(depth*2, ' ')
-        << "$upscope $end\n";
+    writer.write(std::string(depth*2, ' ')+"$upscope $end\n");
   }
 }
 
 /*******************************************************************\
 
+Function: vcd_add_signal
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: assigns the signal its identifier code; returns false
+          if the signal is not shown
+
+\*******************************************************************/
+
+static bool vcd_add_signal(
+  const namespacet &ns,
+  const irep_idt &identifier,
+  vcd_writert &writer,
+  std::set<irep_idt> &ids,
+  vcd_signal_mapt &signal_map)
+{
+  const symbolt &symbol=ns.lookup(identifier);
+
+  if(symbol.is_auxiliary)
+    return false;
+
+  mp_integer width=vcd_width(symbol.type, ns);
+
+  if(width<1)
+    return false;
+
+  signal_map[symbol.name]=
+    writer.add_signal(width.to_ulong(), symbol.type.id()==ID_bool);
+  ids.insert(symbol.name);
+
+  return true;
+}
+
+/*******************************************************************\
+
+Function: vcd_definitions
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+static void vcd_definitions(
+  const namespacet &ns,
+  const std::string &module_name,
+  const std::set<irep_idt> &ids,
+  const vcd_signal_mapt &signal_map,
+  vcd_writert &writer)
+{
+  writer.write("$scope module "+vcd_identifier(module_name)+" $end\n");
+
+  // split up into hierarchy
+  vcd_hierarchy_rec(ns, ids, signal_map, module_name+".", writer, 1);
+  
+  writer.write("$upscope $end\n");
+
+  writer.write("$enddefinitions $end\n");
+}
+
+/*******************************************************************\
+
+Function: vcd_date
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+static void vcd_date(vcd_writert &writer)
+{
+  time_t t;
+  time(&t);
+  writer.write("$date\n  "+std::string(ctime(&t))+"$end\n");
+
+  writer.write("$timescale\n  1ns\n$end\n");
+}
+
+/*******************************************************************\
+
 Function: show_trans_trace_vcd
 
   Inputs:
@@ -641,11 +789,9 @@ void show_trans_trace_vcd(
   const namespacet &ns,
   std::ostream &out)
 {
-  time_t t;
-  time(&t);
-  out << "$date\n  " << ctime(&t) << "$end" << '\n';
+  vcd_writert writer(out);
 
-  out << "$timescale\n  1ns\n$end" << '\n';
+  vcd_date(writer);
   
   if(trace.states.empty()) return;
 
@@ -656,34 +802,116 @@ void show_trans_trace_vcd(
   const symbolt &symbol1=ns.lookup(
     state.assignments.front().lhs.get(ID_identifier));
 
-  std::string module_name=id2string(symbol1.module);
-  out << "$scope module " << vcd_identifier(module_name) << " $end\n";
-  
-  // get identifiers
+  // get identifiers, and assign each signal its code once
   std::set<irep_idt> ids;
+  vcd_signal_mapt signal_map;
   
   for(const auto & a : state.assignments)
   {
     assert(a.lhs.id()==ID_symbol);
-    ids.insert(to_symbol_expr(a.lhs).get_identifier());
+    vcd_add_signal(
+      ns, to_symbol_expr(a.lhs).get_identifier(), writer, ids, signal_map);
   }
   
-  // split up into hierarchy
-  vcd_hierarchy_rec(ns, ids, module_name+".", out, 1);
-  
-  out << "$upscope $end\n";  
-
-  out << "$enddefinitions $end\n";
+  vcd_definitions(ns, id2string(symbol1.module), ids, signal_map, writer);
   
   unsigned l=trace.get_min_failing_timeframe();
   
-  // initial state
+  for(unsigned t=0; t<=l; t++)
+    show_trans_state_vcd(t, trace.states[t], signal_map, ns, writer);
+}
 
-  show_trans_state_vcd(0, trace.states[0], trace.states[0], ns, out);
-  
-  // following ones
+/*******************************************************************\
 
-  for(unsigned t=1; t<=l; t++)
-    show_trans_state_vcd(t, trace.states[t-1], trace.states[t], ns, out);
-}
+Function: show_trans_trace_vcd
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: as above, but takes the bits of bit-vector signals
+          straight from the packed trace
+
+\*******************************************************************/
+
+void show_trans_trace_vcd(
+  const packed_trans_tracet &trace,
+  messaget &message,
+  const namespacet &ns,
+  std::ostream &out)
+{
+  vcd_writert writer(out);
+
+  vcd_date(writer);
+
+  if(trace.empty() || trace.signals.empty()) return;
+
+  const symbolt &symbol1=ns.lookup(trace.signals.front().identifier);
+
+  std::set<irep_idt> ids;
+  vcd_signal_mapt signal_map;
+
+  struct shownt
+  {
+    const packed_trans_tracet::signalt *signal;
+    vcd_writert::signalt vcd_signal;
+    bool raw;
+  };
+
+  std::vector<shownt> shown;
+  std::size_t max_words=0;
 
+  for(const auto &signal : trace.signals)
+  {
+    if(!vcd_add_signal(ns, signal.identifier, writer, ids, signal_map))
+      continue;
+
+    shownt s;
+    s.signal=&signal;
+    s.vcd_signal=signal_map[signal.identifier];
+
+    // The bits of Booleans and bit-vectors are in VCD order,
+    // anything else goes through the expression.
+    const typet &type=ns.follow(signal.type);
+    s.raw=(type.id()==ID_bool ||
+           type.id()==ID_unsignedbv ||
+           type.id()==ID_signedbv ||
+           type.id()==ID_bv) &&
+          writer.width(s.vcd_signal)==signal.width;
+
+    shown.push_back(s);
+    max_words=std::max(max_words, packed_trans_tracet::words(signal.width));
+  }
+
+  vcd_definitions(ns, id2string(symbol1.module), ids, signal_map, writer);
+
+  const std::vector<vcd_writert::wordt> all_known(max_words, 0);
+
+  unsigned l=trace.get_min_failing_timeframe();
+
+  for(unsigned t=0; t<=l; t++)
+  {
+    writer.timestamp(t);
+
+    for(const auto &s : shown)
+    {
+      if(s.raw)
+      {
+        const packed_trans_tracet::wordt *u=
+          trace.unknown_words(*s.signal, t);
+
+        writer.change(
+          s.vcd_signal,
+          trace.value_words(*s.signal, t),
+          u==nullptr?all_known.data():u);
+      }
+      else
+      {
+        exprt value=trace.get_value(*s.signal, t);
+
+        if(value.is_not_nil())
+          writer.change(s.vcd_signal, as_vcd_binary(value, ns));
+      }
+    }
+  }
+}
@@ -61,6 +61,11 @@ void convert(
   const namespacet &,
   const trans_tracet &,
   class xmlt &);
+
+void convert(
+  const namespacet &,
+  const trans_tracet &,
+  class json_objectt &);
         
 void show_trans_trace(
   const trans_tracet &trace,
@@ -86,7 +86,8 @@ Function: compute_trans_trace
 
  Outputs:
 
- Purpose:
+ Purpose: reads the values of the latches, inputs and wires
+          directly from the solver into the packed columns
 
 \*******************************************************************/
 
@@ -95,62 +96,105 @@ void compute_trans_trace(
   const bmc_mapt &bmc_map,
   const propt &solver,
   const namespacet &ns,
-  trans_tracet &dest)
+  packed_trans_tracet &dest)
 {
-  dest.states.reserve(bmc_map.get_no_timeframes());
-  
-  for(unsigned t=0; t<bmc_map.get_no_timeframes(); t++)
+  typedef packed_trans_tracet::wordt wordt;
+
+  const unsigned no_timeframes=bmc_map.get_no_timeframes();
+
+  dest.clear();
+
+  std::vector<wordt> unknown;
+
+  for(var_mapt::mapt::const_iterator
+      it=bmc_map.var_map.map.begin();
+      it!=bmc_map.var_map.map.end();
+      it++)
   {
-    dest.states.push_back(trans_tracet::statet());
-    trans_tracet::statet &state=dest.states.back();
-  
-    for(var_mapt::mapt::const_iterator
-        it=bmc_map.var_map.map.begin();
-        it!=bmc_map.var_map.map.end();
-        it++)
-    {
-      const var_mapt::vart &var=it->second;
+    const var_mapt::vart &var=it->second;
+
+    // we show latches, inputs, wires
+    if(!var.is_latch() && !var.is_input() && !var.is_wire())
+      continue;
+
+    dest.signals.push_back(packed_trans_tracet::signalt());
+    packed_trans_tracet::signalt &signal=dest.signals.back();
+
+    signal.identifier=it->first;
+    signal.type=var.type;
+    signal.width=var.bits.size();
+    signal.value_offset=dest.values.size();
+    signal.unknown_offset=packed_trans_tracet::signalt::no_offset;
 
-      // we show latches, inputs, wires      
-      if(!var.is_latch() && !var.is_input() && !var.is_wire())
-        continue;
-        
-      const symbolt &symbol=ns.lookup(it->first);
+    const std::size_t no_words=packed_trans_tracet::words(signal.width);
 
-      std::string value;
-      value.reserve(var.bits.size());
+    dest.values.resize(dest.values.size()+no_words*no_timeframes, 0);
+    unknown.assign(no_words*no_timeframes, 0);
 
-      for(unsigned i=0; i<var.bits.size(); i++)
+    wordt *v=dest.values.data()+signal.value_offset;
+    bool has_unknown=false;
+
+    for(unsigned t=0; t<no_timeframes; t++)
+    {
+      for(std::size_t i=0; i<var.bits.size(); i++)
       {
         literalt l=bmc_map.get(t, var.bits[i]);
 
-        char ch;
+        const std::size_t word_nr=
+          t*no_words+i/packed_trans_tracet::word_bits;
+        const wordt bit=wordt(1)<<(i%packed_trans_tracet::word_bits);
 
         switch(solver.l_get(l).get_value())
         {
-         case tvt::tv_enumt::TV_TRUE: ch='1'; break;
-         case tvt::tv_enumt::TV_FALSE: ch='0'; break;
+         case tvt::tv_enumt::TV_TRUE: v[word_nr]|=bit; break;
+         case tvt::tv_enumt::TV_FALSE: break;
          case tvt::tv_enumt::TV_UNKNOWN:
-         default: ch='?'; break;
+         default: unknown[word_nr]|=bit; has_unknown=true; break;
         }
-
-        value=ch+value;
       }
-      
-      state.assignments.push_back(trans_tracet::statet::assignmentt());
-
-      trans_tracet::statet::assignmentt &assignment=
-        state.assignments.back();
+    }
 
-      assignment.lhs=symbol.symbol_expr();
-      assignment.rhs=bitstring_to_expr(value, var.type);
-      assignment.location.make_nil();
+    // three-valued columns only where needed
+    if(has_unknown)
+    {
+      signal.unknown_offset=dest.unknowns.size();
+      dest.unknowns.insert(dest.unknowns.end(), unknown.begin(), unknown.end());
     }
+  }
+
+  // check the property
+  dest.property_failed.resize(no_timeframes, false);
 
-    // check the property
+  for(unsigned t=0; t<no_timeframes; t++)
+  {
     assert(t<prop_bv.size());
     tvt result=solver.l_get(prop_bv[t]);
-    state.property_failed=result.is_false();
+    dest.property_failed[t]=result.is_false();
   }
-}         
-          
+}
+
+/*******************************************************************\
+
+Function: compute_trans_trace
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void compute_trans_trace(
+  const bvt &prop_bv,
+  const bmc_mapt &bmc_map,
+  const propt &solver,
+  const namespacet &ns,
+  trans_tracet &dest)
+{
+  packed_trans_tracet packed;
+
+  compute_trans_trace(prop_bv, bmc_map, solver, ns, packed);
+
+  packed.materialise(ns, dest);
+}
@@ -10,8 +10,11 @@ Author: Daniel Kroening, kroening@kroening.com
 #define CPROVER_TRANS_TRACE_NETLIST_H
 
 #include "bmc_map.h"
+#include "packed_trans_trace.h"
 #include "trans_trace.h"
 
+exprt bitstring_to_expr(const std::string &src, const typet &type);
+
 void compute_trans_trace(
   const bvt &prop_bv,
   const bmc_mapt &bmc_map,
@@ -19,4 +22,11 @@ void compute_trans_trace(
   const namespacet &ns,
   trans_tracet &dest);
 
+void compute_trans_trace(
+  const bvt &prop_bv,
+  const bmc_mapt &bmc_map,
+  const class propt &solver,
+  const namespacet &ns,
+  packed_trans_tracet &dest);
+
 #endif
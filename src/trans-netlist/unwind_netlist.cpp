@@ -6,6 +6,8 @@ Author: Daniel Kroening, kroening@kroening.com
 
 \*******************************************************************/
 
+#include <cassert>
+
 #include "unwind_netlist.h"
 #include "instantiate_netlist.h"
 
@@ -13,6 +15,144 @@ Author: Daniel Kroening, kroening@kroening.com
 
 /*******************************************************************\
 
+Function: equal_addresses
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+static literalt equal_addresses(
+  cnft &solver,
+  const bvt &a,
+  const bvt &b)
+{
+  assert(a.size()==b.size());
+
+  bvt equal_bits;
+  equal_bits.reserve(a.size());
+
+  for(std::size_t i=0; i<a.size(); i++)
+    equal_bits.push_back(solver.lequal(a[i], b[i]));
+
+  return solver.land(equal_bits);
+}
+
+/*******************************************************************\
+
+Function: implies_equal_data
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: add clauses for  condition -> a=b
+
+\*******************************************************************/
+
+static void implies_equal_data(
+  cnft &solver,
+  literalt condition,
+  const bvt &a,
+  const bvt &b)
+{
+  assert(a.size()==b.size());
+
+  for(std::size_t i=0; i<a.size(); i++)
+  {
+    solver.lcnf(!condition, !a[i], b[i]);
+    solver.lcnf(!condition, a[i], !b[i]);
+  }
+}
+
+/*******************************************************************\
+
+Function: unwind_memories
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: Constrain the data of the reads in the given timeframe.
+          A read returns the data of the latest enabled write to
+          the same address; reads that see no such write return
+          the initial contents, and hence agree with each other
+          whenever their addresses are equal.
+
+\*******************************************************************/
+
+static void unwind_memories(
+  const netlistt &netlist,
+  bmc_mapt &bmc_map,
+  cnft &solver,
+  unsigned t)
+{
+  for(std::size_t m=0; m<netlist.memories.size(); m++)
+  {
+    const netlistt::memoryt &memory=netlist.memories[m];
+    bmc_mapt::memory_readst &reads=bmc_map.memory_reads[m];
+
+    for(const auto &read_port : memory.read_ports)
+    {
+      bmc_mapt::memory_readt read;
+
+      for(const auto &l : read_port.address)
+        read.address.push_back(bmc_map.translate(t, l));
+
+      for(const auto &l : read_port.data)
+        read.data.push_back(bmc_map.translate(t, l));
+
+      // a write in timeframe t' is visible from t'+1 on;
+      // go from the latest write backwards
+      literalt written=const_literal(false);
+
+      for(unsigned t_w=t; t_w!=0; t_w--)
+      {
+        for(std::size_t w=memory.write_ports.size(); w!=0; w--)
+        {
+          const netlistt::memoryt::write_portt &write_port=
+            memory.write_ports[w-1];
+
+          bvt address, data;
+
+          for(const auto &l : write_port.address)
+            address.push_back(bmc_map.translate(t_w-1, l));
+
+          for(const auto &l : write_port.data)
+            data.push_back(bmc_map.translate(t_w-1, l));
+
+          literalt match=solver.land(
+            bmc_map.translate(t_w-1, write_port.enable),
+            equal_addresses(solver, read.address, address));
+
+          implies_equal_data(
+            solver, solver.land(match, !written), read.data, data);
+
+          written=solver.lor(written, match);
+        }
+      }
+
+      read.initial=!written;
+
+      for(const auto &other : reads)
+      {
+        literalt same=solver.land(
+          solver.land(read.initial, other.initial),
+          equal_addresses(solver, read.address, other.address));
+
+        implies_equal_data(solver, same, read.data, other.data);
+      }
+
+      reads.push_back(read);
+    }
+  }
+}
+
+/*******************************************************************\
+
 Function: unwind
 
   Inputs:
@@ -72,6 +212,10 @@ void unwind(
   for(const auto & c : netlist.transition)
     solver.l_set_to(bmc_map.translate(t, c), true);
 
+  // memories that are not bit-blasted
+  if(!netlist.memories.empty())
+    unwind_memories(netlist, bmc_map, solver, t);
+
   if(!last)
   {     
     // joining the latches between timeframe and timeframe+1
@@ -0,0 +1,249 @@
+/*******************************************************************\
+
+Module: Streaming VCD Output
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+#include <cassert>
+#include <ostream>
+
+#include "vcd_writer.h"
+
+/*******************************************************************\
+
+Function: vcd_writert::id_code_of
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: the VCD identifier code for the signal with the given
+          index, using the printable ASCII characters ! to ~
+
+\*******************************************************************/
+
+std::string vcd_writert::id_code_of(std::size_t index)
+{
+  const std::size_t base='~'-'!'+1;
+  std::string result;
+
+  do
+  {
+    result+=char('!'+index%base);
+    index/=base;
+  }
+  while(index!=0);
+
+  return result;
+}
+
+/*******************************************************************\
+
+Function: vcd_writert::add_signal
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+vcd_writert::signalt vcd_writert::add_signal(
+  std::size_t width,
+  bool scalar)
+{
+  signalt signal=signals.size();
+
+  signals.push_back(signal_infot());
+  signal_infot &info=signals.back();
+  info.width=width;
+  info.offset=value_words.size();
+  info.scalar=scalar && width==1;
+  info.has_value=false;
+  info.id_code=id_code_of(signal);
+
+  value_words.resize(value_words.size()+words(width), 0);
+  unknown_words.resize(unknown_words.size()+words(width), 0);
+
+  return signal;
+}
+
+/*******************************************************************\
+
+Function: vcd_writert::timestamp
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void vcd_writert::timestamp(unsigned t)
+{
+  buffer+='#';
+  buffer+=std::to_string(t);
+  buffer+='\n';
+}
+
+/*******************************************************************\
+
+Function: vcd_writert::change
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+bool vcd_writert::change(signalt signal, const std::string &bits)
+{
+  assert(signal<signals.size());
+  const std::size_t width=signals[signal].width;
+  const std::size_t no_words=words(width);
+
+  tmp_value.assign(no_words, 0);
+  tmp_unknown.assign(no_words, 0);
+
+  // bits are given MSB first; missing bits are unknown
+  for(std::size_t i=0; i<width; i++)
+  {
+    char ch=i<bits.size()?bits[bits.size()-1-i]:'x';
+    wordt bit=wordt(1)<<(i%word_bits);
+
+    if(ch=='1')
+      tmp_value[i/word_bits]|=bit;
+    else if(ch!='0')
+      tmp_unknown[i/word_bits]|=bit;
+  }
+
+  return change(signal, tmp_value.data(), tmp_unknown.data());
+}
+
+/*******************************************************************\
+
+Function: vcd_writert::change
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+bool vcd_writert::change(
+  signalt signal,
+  const wordt *value,
+  const wordt *unknown)
+{
+  assert(signal<signals.size());
+  signal_infot &info=signals[signal];
+  const std::size_t no_words=words(info.width);
+
+  if(no_words==0)
+    return false;
+
+  const std::size_t rest=info.width%word_bits;
+  const wordt last_mask=rest==0?~wordt(0):(wordt(1)<<rest)-1;
+
+  wordt *v=value_words.data()+info.offset;
+  wordt *u=unknown_words.data()+info.offset;
+
+  bool changed=!info.has_value;
+
+  for(std::size_t i=0; i<no_words; i++)
+  {
+    wordt mask=(i+1==no_words)?last_mask:~wordt(0);
+    wordt new_u=unknown[i]&mask;
+    wordt new_v=value[i]&mask&~new_u;
+
+    if(v[i]!=new_v || u[i]!=new_u)
+    {
+      v[i]=new_v;
+      u[i]=new_u;
+      changed=true;
+    }
+  }
+
+  if(!changed)
+    return false;
+
+  info.has_value=true;
+  emit(info);
+
+  return true;
+}
+
+/*******************************************************************\
+
+Function: vcd_writert::emit
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void vcd_writert::emit(const signal_infot &info)
+{
+  const wordt *v=value_words.data()+info.offset;
+  const wordt *u=unknown_words.data()+info.offset;
+
+  if(!info.scalar)
+    buffer+='b';
+
+  for(std::size_t i=info.width; i!=0; i--)
+  {
+    std::size_t bit_nr=i-1;
+    wordt bit=wordt(1)<<(bit_nr%word_bits);
+
+    if(u[bit_nr/word_bits]&bit)
+      buffer+='x';
+    else if(v[bit_nr/word_bits]&bit)
+      buffer+='1';
+    else
+      buffer+='0';
+  }
+
+  // scalars are special -- no space!
+  if(!info.scalar)
+    buffer+=' ';
+
+  buffer+=info.id_code;
+  buffer+='\n';
+
+  if(buffer.size()>=buffer_size)
+    flush();
+}
+
+/*******************************************************************\
+
+Function: vcd_writert::flush
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void vcd_writert::flush()
+{
+  if(!buffer.empty())
+  {
+    out.write(buffer.data(), buffer.size());
+    buffer.clear();
+  }
+
+  out.flush();
+}
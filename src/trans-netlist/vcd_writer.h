@@ -0,0 +1,108 @@
+/*******************************************************************\
+
+Module: Streaming VCD Output
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+#ifndef CPROVER_TRANS_VCD_WRITER_H
+#define CPROVER_TRANS_VCD_WRITER_H
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+// Writes value change dumps. Every signal gets a short identifier
+// code once, its last value is kept as packed value/unknown words,
+// and a change is only emitted when these words differ.
+// All output is collected in a large buffer before being handed
+// to the underlying stream.
+
+class vcd_writert
+{
+public:
+  typedef std::size_t signalt;
+  typedef std::uint64_t wordt;
+
+  explicit vcd_writert(std::ostream &_out):out(_out)
+  {
+    buffer.reserve(buffer_size);
+  }
+
+  ~vcd_writert()
+  {
+    flush();
+  }
+
+  // registers a signal with the given number of bits
+  signalt add_signal(std::size_t width, bool scalar);
+
+  const std::string &id_code(signalt signal) const
+  {
+    return signals[signal].id_code;
+  }
+
+  std::size_t width(signalt signal) const
+  {
+    return signals[signal].width;
+  }
+
+  // raw text, e.g., for the header
+  void write(const std::string &s)
+  {
+    buffer+=s;
+    if(buffer.size()>=buffer_size)
+      flush();
+  }
+
+  void timestamp(unsigned t);
+
+  // Value given as string over 0/1/x, most significant bit first.
+  // Returns true iff a change was emitted.
+  bool change(signalt signal, const std::string &bits);
+
+  // Value given as packed words, bit 0 is the least significant
+  // bit; set bits in 'unknown' denote x.
+  bool change(
+    signalt signal,
+    const wordt *value,
+    const wordt *unknown);
+
+  void flush();
+
+  static std::string id_code_of(std::size_t index);
+
+  static std::size_t words(std::size_t width)
+  {
+    return (width+word_bits-1)/word_bits;
+  }
+
+  static const std::size_t word_bits=64;
+
+protected:
+  std::ostream &out;
+  std::string buffer;
+
+  static const std::size_t buffer_size=1<<20;
+
+  struct signal_infot
+  {
+    std::size_t width;
+    std::size_t offset; // into value_words and unknown_words
+    bool scalar;
+    bool has_value;
+    std::string id_code;
+  };
+
+  std::vector<signal_infot> signals;
+  std::vector<wordt> value_words, unknown_words;
+
+  // scratch space for packing strings
+  std::vector<wordt> tmp_value, tmp_unknown;
+
+  void emit(const signal_infot &);
+};
+
+#endif
@@ -9,6 +9,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <cstdlib>
 
 #include <util/namespace.h>
+#include <util/std_expr.h>
 
 #include "instantiate_word_level.h"
 #include "property.h"
@@ -57,3 +58,49 @@ void property(const exprt &property_expr, bvt &prop_bv,
     prop_bv.push_back(l);
   }
 }
+
+/*******************************************************************\
+
+Function: property
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void property(const exprt &property_expr, exprt::operandst &prop_handles,
+              message_handlert &message_handler, decision_proceduret &solver,
+              unsigned no_timeframes, const namespacet &ns) {
+  messaget message(message_handler);
+
+  prop_handles.clear();
+
+  if(property_expr.is_true())
+  {
+    prop_handles.resize(no_timeframes, true_exprt());
+    return;
+  }
+
+  if(property_expr.id()!=ID_AG &&
+     property_expr.id()!=ID_sva_always)
+  {
+    message.error() << "unsupported property - only SVA always implemented"
+                    << messaget::eom;
+    exit(1);
+  }
+
+  assert(property_expr.operands().size()==1);
+
+  const exprt &p=property_expr.op0();
+
+  for(unsigned c=0; c<no_timeframes; c++)
+  {
+    exprt tmp=
+      instantiate(p, c, no_timeframes, ns);
+
+    prop_handles.push_back(solver.handle(tmp));
+  }
+}
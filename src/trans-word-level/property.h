@@ -13,6 +13,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/message.h>
 #include <util/namespace.h>
 
+#include <solvers/decision_procedure.h>
 #include <solvers/prop/literal.h>
 #include <solvers/prop/prop_conv_solver.h>
 
@@ -20,4 +21,10 @@ void property(const exprt &property_expr, bvt &prop_bv, message_handlert &,
               prop_conv_solvert &solver, unsigned no_timeframes,
               const namespacet &);
 
+// for solvers that are not propositional, e.g., SMT-LIB2;
+// one handle per timeframe
+void property(const exprt &property_expr, exprt::operandst &prop_handles,
+              message_handlert &, decision_proceduret &solver,
+              unsigned no_timeframes, const namespacet &);
+
 #endif
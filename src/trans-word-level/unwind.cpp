@@ -72,3 +72,35 @@ void unwind(const transt &trans, message_handlert &message_handler,
         instantiate(op_trans, t, no_timeframes, ns));
     }
 }
+
+/*******************************************************************\
+
+Function: unwind_timeframe
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void unwind_timeframe(const transt &trans,
+                      decision_proceduret &decision_procedure, unsigned t,
+                      const namespacet &ns, bool initial_state) {
+  // The number of timeframes only matters for temporal
+  // operators, which do not occur in the transition system.
+  const unsigned no_timeframes=t+1;
+
+  if(!trans.invar().is_true())
+    decision_procedure.set_to_true(
+      instantiate(trans.invar(), t, no_timeframes, ns));
+
+  if(initial_state && t==0 && !trans.init().is_true())
+    decision_procedure.set_to_true(
+      instantiate(trans.init(), 0, no_timeframes, ns));
+
+  if(!trans.trans().is_true())
+    decision_procedure.set_to_true(
+      instantiate(trans.trans(), t, no_timeframes, ns));
+}
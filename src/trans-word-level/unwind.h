@@ -20,4 +20,13 @@ void unwind(const transt &trans, message_handlert &message_handler,
             unsigned no_timeframes, const class namespacet &ns,
             bool initial_state = true);
 
+// Adds the constraints for timeframe 't' only, i.e., the invariant,
+// the initial state if t is 0, and the transition t->t+1.
+// Used for deepening the unwinding incrementally.
+
+void unwind_timeframe(const transt &trans,
+                      class decision_proceduret &decision_procedure,
+                      unsigned t, const class namespacet &ns,
+                      bool initial_state = true);
+
 #endif
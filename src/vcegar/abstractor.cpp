@@ -8,7 +8,10 @@ Date: April 2004
 
 \*******************************************************************/
 
+#include <algorithm>
+#include <atomic>
 #include <map>
+#include <thread>
 #include <vector>
 
 #include <util/namespace.h>
@@ -16,7 +19,6 @@ Date: April 2004
 
 #include <verilog/expr2verilog.h>
 #include <solvers/flattening/boolbv.h>
-#include <satqe/satqe_satcheck.h>
 #include <trans-word-level/instantiate_word_level.h>
 #include <trans-netlist/unwind_netlist.h>
 
@@ -277,6 +279,13 @@ void abstractort::calc_trans_rel_abstraction(
    
   //Remove the old clusters
   abstract_trans.abstract_trans_vector.clear();
+
+  // With several threads, the predicates of all clusters that
+  // miss the cache are converted first, and solved afterwards.
+  parallel_solvert *parallel_solver=
+    num_threads>1?&get_parallel_trans_solver(trans, ns):nullptr;
+
+  cluster_jobst jobs;
    
   for(partitioningt::predicate_clusterst::const_iterator
       it=pred_clusters.begin();
@@ -313,7 +322,32 @@ void abstractort::calc_trans_rel_abstraction(
       }
     }
        
-    if(!trans_rel_caching || !cache_hit)
+    if((!trans_rel_caching || !cache_hit) && parallel_solver!=nullptr)
+    {
+      jobs.push_back(cluster_jobt());
+      cluster_jobt &job=jobs.back();
+
+      job.index=abstract_trans.abstract_trans_vector.size()-1;
+      job.id_set=trans_id_set;
+
+      std::vector<exprt> cluster_predicates;
+      split_cluster(
+        *it, cluster_predicates, abstract_trans.abstract_trans_vector.back());
+
+      job.important.reserve(cluster_predicates.size());
+
+      for(unsigned j=0; j<cluster_predicates.size(); j++)
+        job.important.push_back(
+          predicate_literal(
+            parallel_solver->boolbv,
+            parallel_solver->predicate_literals,
+            cluster_predicates[j],
+            ns));
+
+      job.activation=parallel_solver->clause_list.new_variable();
+      i++;
+    }
+    else if(!trans_rel_caching || !cache_hit)
     {
       calc_abstract_trans_rel(
         *it, 
@@ -322,16 +356,47 @@ void abstractort::calc_trans_rel_abstraction(
 	abstract_trans.abstract_trans_vector.back(),
 	ns);
 	 
-      trans_cubes_cache.insert(
-        std::pair <partitioningt::pred_id_set_pairt, 
-		   abstract_transition_relationt>
-	  (trans_id_set, abstract_trans.abstract_trans_vector.back()));
+      if(trans_rel_caching)
+        trans_cubes_cache.insert(
+          std::pair <partitioningt::pred_id_set_pairt, 
+		     abstract_transition_relationt>
+	    (trans_id_set, abstract_trans.abstract_trans_vector.back()));
       i++;
     }
      
     if(it->size() > max_trans_cluster_size)
       max_trans_cluster_size = it->size();
   }
+
+  if(!jobs.empty())
+  {
+    run_cluster_jobs(*parallel_solver, jobs);
+
+    // merge in the order of the clusters, as in the sequential case
+    for(cluster_jobst::iterator
+        j_it=jobs.begin();
+        j_it!=jobs.end();
+        j_it++)
+    {
+      abstract_transition_relationt &abstract_transition_relation=
+        abstract_trans.abstract_trans_vector[j_it->index];
+
+      debug() << "Generated "
+              << i2string(j_it->cubes.no_insertions()) << " cube(s)"
+              << eom;
+
+      if(show_cubes)
+        std::cout << j_it->cubes;
+
+      abstract_transition_relation.cubes.swap(j_it->cubes);
+
+      if(trans_rel_caching)
+        trans_cubes_cache.insert(
+          std::pair <partitioningt::pred_id_set_pairt, 
+		     abstract_transition_relationt>
+	    (j_it->id_set, abstract_transition_relation));
+    }
+  }
    
   num_trans_clusters = abstract_trans.abstract_trans_vector.size();
 }
@@ -431,32 +496,368 @@ void abstractort::refinement_guided_partitioning_abstraction(
 
 /*******************************************************************\
 
-Function: abstractort::calc_abstract_trans_rel
+Function: abstractort::get_trans_solver
 
   Inputs:
 
  Outputs:
 
- Purpose: compute abstract transition relation according to the
-          given set of predicates.
-          Predicates contains a mixture of current state and next
-          state predicates.  
+ Purpose: the solver holding trans, invar@0 and invar@1, which
+          is built on first use
 
 \*******************************************************************/
 
-void abstractort::calc_abstract_trans_rel(
-  const predicatest &cluster, 
-  const concrete_transt &concrete_trans,
-  const transt &trans, //follow macros is assumed to be done
-  abstract_transition_relationt &abstract_transition_relation,
+abstractort::incremental_solvert &abstractort::get_trans_solver(
+  const transt &trans,
   const namespacet &ns)
 {
-  //It is assumed that follow macros has already been called for
-  // the concrete transition relation and predicates in the "cluster".
+  if(!trans_solver)
+  {
+    trans_solver=std::unique_ptr<incremental_solvert>(
+      new incremental_solvert(ns));
+
+    trans_solver->satcheck.set_message_handler(get_message_handler());
+    trans_solver->boolbv.set_message_handler(get_message_handler());
+
+    exprt instantiated_trans(trans.trans());
+    instantiate(instantiated_trans, 0, ns);
+  
+    exprt instantiated_invar0(trans.invar());
+    instantiate(instantiated_invar0, 0, ns);
+
+    exprt instantiated_invar1(trans.invar());
+    instantiate(instantiated_invar1, 1, ns);
+  
+    trans_solver->boolbv.set_to_true(instantiated_invar0);
+    trans_solver->boolbv.set_to_true(instantiated_invar1);
+    trans_solver->boolbv.set_to_true(instantiated_trans);
+  }
+
+  return *trans_solver;
+}
+
+/*******************************************************************\
+
+Function: abstractort::get_init_solver
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: the solver holding init@0 and invar@0, which
+          is built on first use
+
+\*******************************************************************/
+
+abstractort::incremental_solvert &abstractort::get_init_solver(
+  const transt &trans,
+  const namespacet &ns)
+{
+  if(!init_solver)
+  {
+    init_solver=std::unique_ptr<incremental_solvert>(
+      new incremental_solvert(ns));
+
+    init_solver->satcheck.set_message_handler(get_message_handler());
+    init_solver->boolbv.set_message_handler(get_message_handler());
+
+    exprt instantiated_invar(trans.invar());
+    instantiate(instantiated_invar, 0, ns);
+
+    exprt instantiated_init(trans.init());
+    instantiate(instantiated_init, 0, ns);
+
+    init_solver->boolbv.set_to_true(instantiated_invar);  
+    init_solver->boolbv.set_to_true(instantiated_init);
+  }
+
+  return *init_solver;
+}
+
+/*******************************************************************\
+
+Function: abstractort::predicate_literal
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: a positive literal for the predicate, shared by all
+          clusters that contain it
+
+\*******************************************************************/
+
+literalt abstractort::predicate_literal(
+  prop_convt &conv,
+  predicate_literalst &predicate_literals,
+  const exprt &predicate,
+  const namespacet &ns)
+{
+  predicate_literalst::const_iterator it=
+    predicate_literals.find(predicate);
+
+  if(it!=predicate_literals.end())
+    return it->second;
+
+  exprt tmp(predicate);
+  instantiate(tmp, 0, ns);
+
+  literalt l=make_pos(conv, tmp);
+
+  predicate_literals[predicate]=l;
+
+  return l;
+}
+
+/*******************************************************************\
+
+Function: abstractort::enumerate_cubes
+
+  Inputs: positive literals of the predicates of the cluster,
+         and an unused activation literal
+
+ Outputs:
+
+ Purpose: all-SAT over the given literals; the blocking clauses
+          are only active under the activation literal
+
+\*******************************************************************/
+
+void abstractort::enumerate_cubes(
+  satcheckt &satcheck,
+  const bvt &important,
+  literalt activation,
+  cube_sett &cube_set)
+{
+  for(unsigned i=0; i<important.size(); i++)
+    satcheck.set_frozen(important[i]);
+
+  satcheck.set_frozen(activation);
+
+  bvt assumptions;
+  assumptions.push_back(activation);
+  satcheck.set_assumptions(assumptions);
+
+  cubest::bitvt stars, bits;
+  stars.resize(important.size(), false);
+  bits.resize(important.size(), false);
+
+  while(true)
+  {
+    switch(satcheck.prop_solve())
+    {
+    case propt::P_SATISFIABLE:
+      {
+        // record cube and block it while the cluster is active
+        bvt blocking_clause;
+        blocking_clause.reserve(important.size()+1);
+
+        for(unsigned i=0; i<important.size(); i++)
+        {
+          tvt value=satcheck.l_get(important[i]);
+
+          if(value.is_true())
+          {
+            bits[i]=true;
+            blocking_clause.push_back(!important[i]);
+          }
+          else if(value.is_false())
+          {
+            bits[i]=false;
+            blocking_clause.push_back(important[i]);
+          }
+          else
+            assert(false);
+        }
+
+        blocking_clause.push_back(!activation);
+
+        cube_set.insert(stars, bits);
+        satcheck.lcnf(blocking_clause);
+      }
+      break;
+
+    case propt::P_UNSATISFIABLE:
+      {
+        // retire the blocking clauses of this cluster
+        satcheck.set_assumptions(bvt());
+        satcheck.l_set_to_false(activation);
+      }
+      return;
+
+    default:
+      throw "unexpected result from incremental all-SAT";
+    }
+  }
+}
+
+/*******************************************************************\
+
+Function: abstractort::get_parallel_trans_solver
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: the clause list holding trans, invar@0 and invar@1,
+          which is built on first use
+
+\*******************************************************************/
+
+abstractort::parallel_solvert &abstractort::get_parallel_trans_solver(
+  const transt &trans,
+  const namespacet &ns)
+{
+  if(!parallel_trans_solver)
+  {
+    parallel_trans_solver=std::unique_ptr<parallel_solvert>(
+      new parallel_solvert(ns));
+
+    parallel_trans_solver->boolbv.set_message_handler(get_message_handler());
+
+    exprt instantiated_trans(trans.trans());
+    instantiate(instantiated_trans, 0, ns);
+  
+    exprt instantiated_invar0(trans.invar());
+    instantiate(instantiated_invar0, 0, ns);
+
+    exprt instantiated_invar1(trans.invar());
+    instantiate(instantiated_invar1, 1, ns);
+  
+    parallel_trans_solver->boolbv.set_to_true(instantiated_invar0);
+    parallel_trans_solver->boolbv.set_to_true(instantiated_invar1);
+    parallel_trans_solver->boolbv.set_to_true(instantiated_trans);
+  }
 
+  return *parallel_trans_solver;
+}
+
+/*******************************************************************\
+
+Function: abstractort::sync_worker
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: copy the clauses the worker has not seen yet
+
+\*******************************************************************/
+
+void abstractort::sync_worker(
+  cnf_clause_listt &clause_list,
+  parallel_solvert::workert &worker)
+{
+  worker.satcheck.set_no_variables(clause_list.no_variables());
+
+  const cnf_clause_listt::clausest &clauses=clause_list.get_clauses();
+
+  std::size_t clause_nr=0;
+
+  for(cnf_clause_listt::clausest::const_iterator
+      it=clauses.begin();
+      it!=clauses.end();
+      it++, clause_nr++)
+  {
+    if(clause_nr>=worker.no_clauses)
+      worker.satcheck.lcnf(*it);
+  }
+
+  worker.no_clauses=clause_nr;
+}
+
+/*******************************************************************\
+
+Function: abstractort::run_cluster_jobs
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: enumerate the cubes of the clusters on up to num_threads
+          workers, each of which owns a copy of the clauses
+
+\*******************************************************************/
+
+void abstractort::run_cluster_jobs(
+  parallel_solvert &solver,
+  cluster_jobst &jobs)
+{
+  const std::size_t no_workers=
+    std::min(std::size_t(num_threads), jobs.size());
+
+  while(solver.workers.size()<no_workers)
+    solver.workers.push_back(std::unique_ptr<parallel_solvert::workert>(
+      new parallel_solvert::workert()));
+
+  std::atomic<std::size_t> next_job(0);
+  std::vector<std::string> errors(no_workers);
+  std::vector<std::thread> threads;
+
+  for(std::size_t w=0; w<no_workers; w++)
+  {
+    parallel_solvert::workert &worker=*solver.workers[w];
+    std::string &error=errors[w];
+
+    threads.push_back(std::thread(
+      [&solver, &jobs, &next_job, &worker, &error]()
+      {
+        try
+        {
+          sync_worker(solver.clause_list, worker);
+
+          // clusters are handed out in order, the cubes
+          // are merged by the caller
+          for(std::size_t j=next_job++; j<jobs.size(); j=next_job++)
+            enumerate_cubes(
+              worker.satcheck,
+              jobs[j].important,
+              jobs[j].activation,
+              jobs[j].cubes);
+        }
+
+        catch(const char *e)
+        {
+          error=e;
+        }
+
+        catch(const std::string &e)
+        {
+          error=e;
+        }
+      }));
+  }
+
+  for(std::size_t w=0; w<threads.size(); w++)
+    threads[w].join();
+
+  for(std::size_t w=0; w<errors.size(); w++)
+    if(!errors[w].empty())
+      throw errors[w];
+}
+
+/*******************************************************************\
+
+Function: abstractort::split_cluster
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: the predicates of the cluster, current state ones first,
+          and their numbers in the abstract transition relation
+
+\*******************************************************************/
+
+void abstractort::split_cluster(
+  const predicatest &cluster,
+  std::vector<exprt> &predicates,
+  abstract_transition_relationt &abstract_transition_relation)
+{
   //Obtain the initial and final set of predicates
-  std::vector<exprt> initial_predicates, final_predicates;
-  std::vector<unsigned> input, output;
+  std::vector<exprt> final_predicates;
+  std::vector<unsigned> &input=abstract_transition_relation.input_predicates;
+  std::vector<unsigned> &output=abstract_transition_relation.output_predicates;
 
   for(unsigned i=0; i<cluster.size(); i++) //No test is made to test if the value
   {                                        //of a predicate does not change.    
@@ -470,7 +871,7 @@ void abstractort::calc_abstract_trans_rel(
     case predicatest::INITIAL:
       {
         input.push_back(nr);
-        initial_predicates.push_back(cluster[i]);
+        predicates.push_back(cluster[i]);
         break;
       }
 
@@ -489,88 +890,76 @@ void abstractort::calc_abstract_trans_rel(
     }
   }
 
+  predicates.insert(
+    predicates.end(), final_predicates.begin(), final_predicates.end());
+
+  if(show_cubes)
+  {
+    std::cout << " Order of cubes:";
+
+    for(unsigned i=0; i<input.size(); i++)
+      std::cout << " " << input[i];
+
+    std::cout <<" |";
+
+    for(unsigned i=0; i<output.size(); i++)
+      std::cout << " " << output[i];
+
+    std::cout << std::endl;
+  }
+}
+
+/*******************************************************************\
+
+Function: abstractort::calc_abstract_trans_rel
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: compute abstract transition relation according to the
+          given set of predicates.
+          Predicates contains a mixture of current state and next
+          state predicates.  
+
+\*******************************************************************/
+
+void abstractort::calc_abstract_trans_rel(
+  const predicatest &cluster, 
+  const concrete_transt &concrete_trans,
+  const transt &trans, //follow macros is assumed to be done
+  abstract_transition_relationt &abstract_transition_relation,
+  const namespacet &ns)
+{
+  //It is assumed that follow macros has already been called for
+  // the concrete transition relation and predicates in the "cluster".
+
+  std::vector<exprt> predicates;
+  split_cluster(cluster, predicates, abstract_transition_relation);
+
   #ifdef DEBUG
   std::cout <<" ASSERTITION REMOVED FOR GCR\n";
   #endif
   //   assert(output.size()!=0);
     
-  // Now obtain the cubes for the abstract transition relation.
-  // We will create a new SAT solver object.
-
-  satqe_satcheckt satqe_satcheck;
-  satqe_satcheck.set_message_handler(get_message_handler());
-   
-  boolbvt boolbv(ns, satqe_satcheck);
-  boolbv.set_message_handler(get_message_handler());
-  
-  exprt instantiated_trans(trans.trans());
-  instantiate(instantiated_trans, 0, ns);
-  
-  exprt instantiated_invar0(trans.invar());
-  instantiate(instantiated_invar0, 0, ns);
+  // Now obtain the cubes for the abstract transition relation,
+  // using the solver that already holds the transition relation.
 
-  exprt instantiated_invar1(trans.invar());
-  instantiate(instantiated_invar1, 1, ns);
-  
-  boolbv.set_to_true(instantiated_invar0);
-  boolbv.set_to_true(instantiated_invar1);
-  boolbv.set_to_true(instantiated_trans);
+  incremental_solvert &solver=get_trans_solver(trans, ns);
 
   cube_sett trans_cube_set;
-  satqe_satcheck.set_cube_set(trans_cube_set);
-    
-  std::vector<unsigned> important_variables;
-  important_variables.reserve(input.size() + output.size());
-    
-  if(show_cubes) 
-    std::cout << " Order of cubes:";
-
-  for(unsigned i=0; i<input.size(); i++)
-  {
-    unsigned p=input[i];
-    exprt tmp(initial_predicates[i]);
-    instantiate(tmp, 0, ns);
     
-    literalt l=make_pos(boolbv, tmp);
-    important_variables.push_back(l.var_no());
-    abstract_transition_relation.input_predicates.push_back(p);
-       
-    if(show_cubes)
-      std::cout << " " << p;
-  }
-   
-  if(show_cubes)
-    std::cout <<" |";
-   
-  for(unsigned i=0; i<output.size(); i++)
-  {
-    unsigned p=output[i];
-    exprt tmp(final_predicates[i]);
-    instantiate(tmp, 0, ns);
-    literalt l=make_pos(boolbv, tmp);
-    important_variables.push_back(l.var_no());
-    abstract_transition_relation.output_predicates.push_back(p);
-
-    if(show_cubes)
-      std::cout << " " << p;
-  }
+  bvt important;
+  important.reserve(predicates.size());
 
-  if(show_cubes)
-    std::cout << std::endl;
-
-  // set important variables
-  satqe_satcheck.set_important_variables(important_variables);
-
-  // solve it
-  switch(boolbv.dec_solve())
-  {
-  case decision_proceduret::D_UNSATISFIABLE:
-    // OK, this is what we expect
-    break;
+  for(unsigned i=0; i<predicates.size(); i++)
+    important.push_back(
+      predicate_literal(
+        solver.boolbv, solver.predicate_literals, predicates[i], ns));
 
-  default:
-    throw "unexpected result from predabs_sat1.solve()";
-  }
+  enumerate_cubes(
+    solver.satcheck, important, solver.satcheck.new_variable(),
+    trans_cube_set);
 
   debug() <<"Generated "
           << i2string(trans_cube_set.no_insertions()) << " cube(s)"
@@ -643,59 +1032,31 @@ void abstractort::calc_abstract_initial_states(
 
   assert(input.size()!=0);
     
-  // Now obtain the cubes for the abstract transition relation.
-  // We will create a new SAT solver object.
+  // Now obtain the cubes for the abstract initial states,
+  // using the solver that already holds the initial states.
   
-  satqe_satcheckt satqe_satcheck;
-  boolbvt boolbv(ns, satqe_satcheck);
-
-  boolbv.set_message_handler(get_message_handler());
-  satqe_satcheck.set_message_handler(get_message_handler());
+  incremental_solvert &solver=get_init_solver(trans, ns);
 
   cube_sett initial;
-  satqe_satcheck.set_cube_set(initial);
-
 
-  exprt instantiated_invar(trans.invar());
-  instantiate(instantiated_invar, 0, ns);
-
-  exprt instantiated_init(trans.init());
-  instantiate(instantiated_init, 0, ns);
-
-  boolbv.set_to_true(instantiated_invar);  
-  boolbv.set_to_true(instantiated_init);
-
-
-  std::vector<unsigned> important_variables;
-  important_variables.reserve(input.size());
+  bvt important;
+  important.reserve(input.size());
 
   for(unsigned i=0; i<input.size(); i++)
   {
     unsigned p=input[i];
-    exprt tmp(initial_predicates[i]);
-    instantiate(tmp, 0, ns);
-    literalt l=make_pos(boolbv, tmp);
-    important_variables.push_back(l.var_no());
+    important.push_back(
+      predicate_literal(
+        solver.boolbv, solver.predicate_literals, initial_predicates[i], ns));
     abstract_initial_states.input_predicates.push_back(p);
   }
 
-  // set important variables
-  satqe_satcheck.set_important_variables(important_variables);
-
-  // solve it
-  switch(boolbv.dec_solve())
-  {
-  case decision_proceduret::D_UNSATISFIABLE:
-    // OK, this is what we expect
-    break;
-
-  default:
-    throw "unexpected result from predabs_sat1.solve()";
-  }
+  enumerate_cubes(
+    solver.satcheck, important, solver.satcheck.new_variable(), initial);
 
   // std::cout<<" The abstract transition relation \n";
-  debug() << "Generated " <<
-          << i2string(initial.no_insertions()) <, " cube(s)\n"
+  debug() << "Generated "
+          << i2string(initial.no_insertions()) << " cube(s)"
           << eom;
 
   if(show_cubes)
@@ -11,10 +11,17 @@ Date: June 2004
 #ifndef CPROVER_ABSTRACTOR_H
 #define CPROVER_ABSTRACTOR_H
 
+#include <memory>
+
 #include <util/message.h>
 #include <util/namespace.h>
 #include <util/cmdline.h>
 
+#include <solvers/sat/cnf_clause_list.h>
+#include <solvers/sat/satcheck.h>
+#include <solvers/flattening/boolbv.h>
+#include <satqe/cube_set.h>
+
 #include "concrete_trans.h"
 #include "abstract_trans.h"
 #include "predicates.h"
@@ -25,9 +32,11 @@ class abstractort:public messaget
 {
 public:
   abstractort(message_handlert &_message_handler,
-	      const cmdlinet &_cmdline) : 
+	      const cmdlinet &_cmdline,
+	      unsigned _num_threads) : 
     messaget(_message_handler),
-    cmdline(_cmdline)
+    cmdline(_cmdline),
+    num_threads(_num_threads)
   {
     //some initializations
     max_trans_cluster_size = 0;
@@ -132,6 +141,9 @@ public:
 
   bool abs_init_states;
 
+  // clusters of the transition relation are abstracted in parallel
+  unsigned num_threads;
+
   // Generates the abstract program given a concrete program
   // and a set of predicates. The concrete program will not be touched.
   // The concrete program is assumed not to change between calls.
@@ -168,6 +180,110 @@ protected:
 
   static void rename_to_next(exprt &current_pred);
 
+  typedef std::map<exprt, literalt> predicate_literalst;
+
+  // The concrete transition relation (or the initial states) is
+  // encoded into one solver that lives as long as the abstractor.
+  // The cubes of each cluster are enumerated with blocking clauses
+  // that are guarded by an activation literal, which is disabled
+  // once the cluster is done.
+  class incremental_solvert
+  {
+  public:
+    explicit incremental_solvert(const namespacet &ns):
+      boolbv(ns, satcheck)
+    {
+    }
+
+    satcheckt satcheck;
+    boolbvt boolbv;
+    predicate_literalst predicate_literals;
+  };
+
+  std::unique_ptr<incremental_solvert> trans_solver, init_solver;
+
+  incremental_solvert &get_trans_solver(
+    const transt &trans,
+    const namespacet &ns);
+
+  incremental_solvert &get_init_solver(
+    const transt &trans,
+    const namespacet &ns);
+
+  // With more than one thread, the transition relation is encoded
+  // once into a clause list, which every worker copies into its own
+  // solver. Only the SAT search runs in the worker threads, as
+  // expressions must not be shared between threads.
+  class parallel_solvert
+  {
+  public:
+    explicit parallel_solvert(const namespacet &ns):
+      boolbv(ns, clause_list)
+    {
+    }
+
+    cnf_clause_listt clause_list;
+    boolbvt boolbv;
+    predicate_literalst predicate_literals;
+
+    class workert
+    {
+    public:
+      workert():no_clauses(0)
+      {
+      }
+
+      satcheckt satcheck;
+
+      // number of clauses copied from clause_list so far
+      std::size_t no_clauses;
+    };
+
+    std::vector<std::unique_ptr<workert> > workers;
+  };
+
+  std::unique_ptr<parallel_solvert> parallel_trans_solver;
+
+  parallel_solvert &get_parallel_trans_solver(
+    const transt &trans,
+    const namespacet &ns);
+
+  // a cluster whose predicates are converted, but not yet solved
+  struct cluster_jobt
+  {
+    std::size_t index;
+    partitioningt::pred_id_set_pairt id_set;
+    bvt important;
+    literalt activation;
+    cube_sett cubes;
+  };
+
+  typedef std::vector<cluster_jobt> cluster_jobst;
+
+  void run_cluster_jobs(parallel_solvert &solver, cluster_jobst &jobs);
+
+  static void sync_worker(
+    cnf_clause_listt &clause_list,
+    parallel_solvert::workert &worker);
+
+  static literalt predicate_literal(
+    prop_convt &conv,
+    predicate_literalst &predicate_literals,
+    const exprt &predicate,
+    const namespacet &ns);
+
+  static void enumerate_cubes(
+    satcheckt &satcheck,
+    const bvt &important,
+    literalt activation,
+    cube_sett &cube_set);
+
+  // input predicates first, then output predicates
+  void split_cluster(
+    const predicatest &cluster,
+    std::vector<exprt> &predicates,
+    abstract_transition_relationt &abstract_transition_relation);
+
 
 
   void calc_abstract_trans_rel
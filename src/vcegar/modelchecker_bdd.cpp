@@ -0,0 +1,721 @@
+/*******************************************************************\
+
+Module: In-process BDD Model Checker for Abstract Models
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+#include <cassert>
+#include <cstdlib>
+
+#include "modelchecker_bdd.h"
+
+/*******************************************************************\
+
+Function: modelchecker_bddt::allocate_vars
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: new predicates get new BDD variables; the ones of
+          earlier iterations are kept
+
+\*******************************************************************/
+
+void modelchecker_bddt::allocate_vars(unsigned no_vars)
+{
+  while(vars.size()<no_vars)
+  {
+    unsigned nr=vars.size();
+    std::string s="b"+std::to_string(nr);
+
+    vars.push_back(vart());
+    vars.back().current=mgr.Var(s);
+    vars.back().next=mgr.Var(s+"'");
+
+    current_var_map[vars.back().current.var()]=nr;
+  }
+}
+
+/*******************************************************************\
+
+Function: modelchecker_bddt::current_to_next
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+modelchecker_bddt::BDD modelchecker_bddt::current_to_next(
+  const BDD &bdd) const
+{
+  BDD tmp=bdd;
+
+  for(const auto &v : vars)
+    tmp=substitute(tmp, v.current.var(), v.next);
+
+  return tmp;
+}
+
+/*******************************************************************\
+
+Function: modelchecker_bddt::next_to_current
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+modelchecker_bddt::BDD modelchecker_bddt::next_to_current(
+  const BDD &bdd) const
+{
+  BDD tmp=bdd;
+
+  for(const auto &v : vars)
+    tmp=substitute(tmp, v.next.var(), v.current);
+
+  return tmp;
+}
+
+/*******************************************************************\
+
+Function: modelchecker_bddt::project_next
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+modelchecker_bddt::BDD modelchecker_bddt::project_next(
+  const BDD &bdd) const
+{
+  BDD tmp=bdd;
+
+  for(const auto &v : vars)
+    tmp=exists(tmp, v.next.var());
+
+  return tmp;
+}
+
+/*******************************************************************\
+
+Function: modelchecker_bddt::project_current
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+modelchecker_bddt::BDD modelchecker_bddt::project_current(
+  const BDD &bdd) const
+{
+  BDD tmp=bdd;
+
+  for(const auto &v : vars)
+    tmp=exists(tmp, v.current.var());
+
+  return tmp;
+}
+
+/*******************************************************************\
+
+Function: modelchecker_bddt::image
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: successors of a set of states
+
+\*******************************************************************/
+
+modelchecker_bddt::BDD modelchecker_bddt::image(
+  const BDD &states,
+  const BDD &trans) const
+{
+  return next_to_current(project_current(states & trans));
+}
+
+/*******************************************************************\
+
+Function: modelchecker_bddt::pre_image
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: predecessors of a set of states
+
+\*******************************************************************/
+
+modelchecker_bddt::BDD modelchecker_bddt::pre_image(
+  const BDD &states,
+  const BDD &trans) const
+{
+  return project_next(current_to_next(states) & trans);
+}
+
+/*******************************************************************\
+
+Function: modelchecker_bddt::cube2bdd
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: same reading of the cubes as in the SMV file
+
+\*******************************************************************/
+
+modelchecker_bddt::BDD modelchecker_bddt::cube2bdd(
+  const std::vector<unsigned> &input,
+  const std::vector<unsigned> &output,
+  const cubest::bitvt &stars,
+  const cubest::bitvt &bits) const
+{
+  assert(stars.size()==input.size()+output.size());
+
+  BDD result=mgr.True();
+  unsigned bit=0;
+
+  for(unsigned i=0; i<input.size(); i++)
+  {
+    if(!stars[i])
+    {
+      assert(bit<bits.size());
+      assert(input[i]<vars.size());
+      const BDD &v=vars[input[i]].current;
+      result=result & (bits[bit]?v:!v);
+      bit++;
+    }
+  }
+
+  for(unsigned i=0; i<output.size(); i++)
+  {
+    if(!stars[i+input.size()])
+    {
+      assert(bit<bits.size());
+      assert(output[i]<vars.size());
+      const BDD &v=vars[output[i]].next;
+      result=result & (bits[bit]?v:!v);
+      bit++;
+    }
+  }
+
+  return result;
+}
+
+/*******************************************************************\
+
+Function: same_cluster
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+static bool same_cluster(
+  const abstract_transition_relationt &a,
+  const abstract_transition_relationt &b)
+{
+  return a.input_predicates==b.input_predicates &&
+         a.output_predicates==b.output_predicates &&
+         a.cubes.star_map==b.cubes.star_map;
+}
+
+/*******************************************************************\
+
+Function: modelchecker_bddt::cluster_bdd
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: the transition constraint of a cluster, rebuilt only
+          if the cluster differs from the one of the last call
+
+\*******************************************************************/
+
+const modelchecker_bddt::BDD &modelchecker_bddt::cluster_bdd(
+  const abstract_transition_relationt &cluster,
+  cached_clustert &cache)
+{
+  if(cache.bdd.is_initialized() && same_cluster(cluster, cache.cluster))
+  {
+    cache_hits++;
+    return cache.bdd;
+  }
+
+  cache_misses++;
+  cache.cluster=cluster;
+
+  // no cubes means no constraint
+  if(cluster.cubes.empty())
+  {
+    cache.bdd=mgr.True();
+    return cache.bdd;
+  }
+
+  BDD result=mgr.False();
+
+  for(const auto &s_it : cluster.cubes.star_map)
+    for(const auto &bits : s_it.second)
+      result=result | cube2bdd(
+        cluster.input_predicates,
+        cluster.output_predicates,
+        s_it.first,
+        bits);
+
+  cache.bdd=result;
+  return cache.bdd;
+}
+
+/*******************************************************************\
+
+Function: modelchecker_bddt::init_bdd
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+const modelchecker_bddt::BDD &modelchecker_bddt::init_bdd(
+  const abstract_initial_statest &initial_states,
+  cached_initt &cache)
+{
+  if(cache.bdd.is_initialized() &&
+     initial_states.input_predicates==
+       cache.initial_states.input_predicates &&
+     initial_states.cubes.star_map==
+       cache.initial_states.cubes.star_map)
+  {
+    cache_hits++;
+    return cache.bdd;
+  }
+
+  cache_misses++;
+  cache.initial_states=initial_states;
+
+  // no predicates means no constraint
+  if(initial_states.input_predicates.empty())
+  {
+    cache.bdd=mgr.True();
+    return cache.bdd;
+  }
+
+  const std::vector<unsigned> no_output;
+  BDD result=mgr.False();
+
+  for(const auto &s_it : initial_states.cubes.star_map)
+    for(const auto &bits : s_it.second)
+      result=result | cube2bdd(
+        initial_states.input_predicates,
+        no_output,
+        s_it.first,
+        bits);
+
+  cache.bdd=result;
+  return cache.bdd;
+}
+
+/*******************************************************************\
+
+Function: modelchecker_bddt::constraint2bdd
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+modelchecker_bddt::BDD modelchecker_bddt::constraint2bdd(
+  const abstract_constraintt &start,
+  const abstract_constraintt &final) const
+{
+  BDD result=mgr.True();
+
+  for(unsigned i=0; i<start.size(); i++)
+  {
+    assert(i<vars.size());
+
+    switch(start[i])
+    {
+    case ZERO: result=result & !vars[i].current; break;
+    case ONE: result=result & vars[i].current; break;
+    case NON_DET: break;
+    }
+  }
+
+  for(unsigned i=0; i<final.size(); i++)
+  {
+    assert(i<vars.size());
+
+    switch(final[i])
+    {
+    case ZERO: result=result & !vars[i].next; break;
+    case ONE: result=result & vars[i].next; break;
+    case NON_DET: break;
+    }
+  }
+
+  return result;
+}
+
+/*******************************************************************\
+
+Function: modelchecker_bddt::weakest_precondition2bdd
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: see modelchecker_smvt::add_weakest_precondition_constrain
+
+\*******************************************************************/
+
+modelchecker_bddt::BDD modelchecker_bddt::weakest_precondition2bdd(
+  const weakest_precondition_constrainst::value_type &c) const
+{
+  const abstract_constraintt &start1=c.first.first;
+  const abstract_constraintt &final1=c.first.second;
+  const abstract_constraintt &start2=c.second.first;
+  const abstract_constraintt &final2=c.second.second;
+
+  // identify the differing predicate in start1 and start2
+  abstract_constraintt start3;
+
+  if(start1.size()==start2.size())
+  {
+    for(unsigned i=0; i<start1.size(); i++)
+      start3.push_back(start1[i]!=start2[i]?NON_DET:start1[i]);
+  }
+  else
+    start3=start1.empty()?start2:start1;
+
+  BDD t1=start1.empty()?mgr.False():constraint2bdd(start1, final1);
+  BDD t2=start2.empty()?mgr.False():constraint2bdd(start2, final2);
+
+  return t1 | t2 | !constraint2bdd(start3, abstract_constraintt());
+}
+
+/*******************************************************************\
+
+Function: modelchecker_bddt::property2bdd
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+modelchecker_bddt::BDD modelchecker_bddt::property2bdd(
+  const exprt &expr) const
+{
+  if(expr.is_true())
+    return mgr.True();
+  else if(expr.is_false())
+    return mgr.False();
+  else if(expr.id()=="predicate_symbol")
+  {
+    unsigned p=atoi(expr.get("identifier").c_str());
+    if(p>=vars.size())
+      throw "invalid predicate in property";
+    return vars[p].current;
+  }
+  else if(expr.id()==ID_not)
+  {
+    assert(expr.operands().size()==1);
+    return !property2bdd(expr.op0());
+  }
+  else if(expr.id()==ID_and)
+  {
+    BDD result=mgr.True();
+    forall_operands(it, expr)
+      result=result & property2bdd(*it);
+    return result;
+  }
+  else if(expr.id()==ID_or)
+  {
+    BDD result=mgr.False();
+    forall_operands(it, expr)
+      result=result | property2bdd(*it);
+    return result;
+  }
+  else if(expr.id()==ID_implies)
+  {
+    assert(expr.operands().size()==2);
+    return (!property2bdd(expr.op0())) | property2bdd(expr.op1());
+  }
+  else if(expr.id()==ID_equal)
+  {
+    assert(expr.operands().size()==2);
+    return !(property2bdd(expr.op0()) ^ property2bdd(expr.op1()));
+  }
+  else if(expr.id()==ID_notequal)
+  {
+    assert(expr.operands().size()==2);
+    return property2bdd(expr.op0()) ^ property2bdd(expr.op1());
+  }
+  else
+    throw "unsupported expression in abstract property: "+expr.id_string();
+}
+
+/*******************************************************************\
+
+Function: modelchecker_bddt::get_state
+
+  Inputs: a non-empty set of states
+
+ Outputs:
+
+ Purpose: pick one state from the set; variables that do not
+          matter are set to false
+
+\*******************************************************************/
+
+void modelchecker_bddt::get_state(
+  const BDD &states,
+  abstract_statet &state) const
+{
+  assert(!states.is_false());
+
+  state.predicate_values.clear();
+  state.predicate_values.resize(vars.size(), false);
+
+  BDD node=states;
+
+  while(!node.is_constant())
+  {
+    bool value=!node.high().is_false();
+
+    std::map<unsigned, unsigned>::const_iterator it=
+      current_var_map.find(node.var());
+
+    if(it!=current_var_map.end())
+      state.predicate_values[it->second]=value;
+
+    // copy before assigning
+    BDD child=value?node.high():node.low();
+    node=child;
+  }
+
+  assert(node.is_true());
+}
+
+/*******************************************************************\
+
+Function: modelchecker_bddt::compute_counterexample
+
+  Inputs: the rings of the forward search, the last one
+          intersects with 'bad'
+
+ Outputs:
+
+ Purpose: walk back through the rings
+
+\*******************************************************************/
+
+void modelchecker_bddt::compute_counterexample(
+  const std::vector<BDD> &rings,
+  const BDD &bad,
+  const BDD &trans,
+  abstract_counterexamplet &counterexample) const
+{
+  assert(!rings.empty());
+
+  std::size_t k=rings.size()-1;
+
+  counterexample.clear();
+  counterexample.resize(k+1);
+
+  get_state(rings[k] & bad, counterexample[k]);
+
+  for(std::size_t i=k; i!=0; i--)
+  {
+    // the chosen state as a BDD
+    BDD state=mgr.True();
+
+    for(unsigned v=0; v<vars.size(); v++)
+      state=state &
+        (counterexample[i].predicate_values[v]?
+           vars[v].current:!vars[v].current);
+
+    BDD predecessors=rings[i-1] & pre_image(state, trans);
+
+    get_state(predecessors, counterexample[i-1]);
+  }
+
+  // trim to the variables of the abstract model
+  for(auto &s : counterexample)
+    s.predicate_values.resize(vars.size());
+}
+
+/*******************************************************************\
+
+Function: modelchecker_bddt::check
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: model check an abstract program using BDDs, return
+          counterexample if failed
+          Return value of TRUE means the program is correct,
+          if FALSE is returned, counterexample will contain
+          the counterexample
+
+\*******************************************************************/
+
+bool modelchecker_bddt::check(
+  const abstract_transt &abstract_trans,
+  const abstract_transition_constrainst &abstract_transition_constrains,
+  const weakest_precondition_constrainst &weakest_precondition_constrains,
+  const abstract_initial_constrainst &abstract_initial_constrains,
+  abstract_counterexamplet &counterexample)
+{
+  allocate_vars(abstract_trans.variables.size());
+
+  cache_hits=cache_misses=0;
+
+  // initial states
+
+  BDD init=mgr.True();
+
+  init_cache.resize(abstract_trans.abstract_init_vector.size());
+
+  for(unsigned i=0; i<abstract_trans.abstract_init_vector.size(); i++)
+    init=init & init_bdd(abstract_trans.abstract_init_vector[i], init_cache[i]);
+
+  for(const auto &c : abstract_initial_constrains)
+  {
+    std::map<abstract_constraintt, BDD>::const_iterator it=
+      initial_constraint_cache.find(c);
+
+    if(it==initial_constraint_cache.end())
+      it=initial_constraint_cache.insert(
+        std::make_pair(c, !constraint2bdd(c, abstract_constraintt()))).first;
+
+    init=init & it->second;
+  }
+
+  // transition relation
+
+  BDD trans=mgr.True();
+
+  trans_cache.resize(abstract_trans.abstract_trans_vector.size());
+
+  for(unsigned i=0; i<abstract_trans.abstract_trans_vector.size(); i++)
+    trans=trans &
+      cluster_bdd(abstract_trans.abstract_trans_vector[i], trans_cache[i]);
+
+  refinement_cache.resize(
+    abstract_trans.refinement_preds_trans_vector.size());
+
+  for(unsigned i=0;
+      i<abstract_trans.refinement_preds_trans_vector.size();
+      i++)
+    trans=trans &
+      cluster_bdd(
+        abstract_trans.refinement_preds_trans_vector[i],
+        refinement_cache[i]);
+
+  for(const auto &c : abstract_transition_constrains)
+  {
+    std::map<abstract_transition_constraintt, BDD>::const_iterator it=
+      transition_constraint_cache.find(c);
+
+    if(it==transition_constraint_cache.end())
+      it=transition_constraint_cache.insert(
+        std::make_pair(c, !constraint2bdd(c.first, c.second))).first;
+
+    trans=trans & it->second;
+  }
+
+  for(const auto &c : weakest_precondition_constrains)
+  {
+    std::map<weakest_precondition_constrainst::value_type, BDD>
+      ::const_iterator it=weakest_precondition_cache.find(c);
+
+    if(it==weakest_precondition_cache.end())
+      it=weakest_precondition_cache.insert(
+        std::make_pair(c, weakest_precondition2bdd(c))).first;
+
+    trans=trans & it->second;
+  }
+
+  statistics() << "Abstract model: " << cache_hits
+               << " cluster BDDs reused, " << cache_misses
+               << " rebuilt" << eom;
+
+  // the property
+
+  exprt property=abstract_trans.abstract_spec.property;
+
+  if(claim)
+  {
+    // only invariants for now
+    if(property.id()==ID_AG && property.operands().size()==1)
+      property=property.op0();
+    else
+      throw "the BDD model checker only supports AG properties";
+  }
+
+  BDD bad=!property2bdd(property);
+
+  // forward search; the rings are the states
+  // first reached in each step
+
+  std::vector<BDD> rings;
+  rings.push_back(init);
+
+  BDD reachable=init;
+
+  while(true)
+  {
+    if(!(rings.back() & bad).is_false())
+    {
+      status() << "BDD model checker produced counterexample" << eom;
+      compute_counterexample(rings, bad, trans, counterexample);
+      break;
+    }
+
+    BDD new_states=image(rings.back(), trans) & !reachable;
+
+    if(new_states.is_false())
+    {
+      statistics() << "BDD nodes: " << mgr.number_of_nodes() << eom;
+      return true;
+    }
+
+    reachable=reachable | new_states;
+    rings.push_back(new_states);
+  }
+
+  statistics() << "BDD nodes: " << mgr.number_of_nodes() << eom;
+
+  return false;
+}
@@ -0,0 +1,132 @@
+/*******************************************************************\
+
+Module: In-process BDD Model Checker for Abstract Models
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+#ifndef CPROVER_MODELCHECKER_BDD_H
+#define CPROVER_MODELCHECKER_BDD_H
+
+#include <map>
+
+#include <solvers/bdd/miniBDD/miniBDD.h>
+
+#include "modelchecker.h"
+
+/* Checks the abstract model by forward reachability with BDDs,
+   without writing and running an external SMV. The manager, the
+   variables and the BDDs of all clusters and constraints are kept
+   across the iterations of the CEGAR loop; a cluster is only
+   rebuilt when its cubes have changed. */
+
+class modelchecker_bddt:public modelcheckert
+{
+public:
+  modelchecker_bddt(message_handlert &_message_handler, bool _claim):
+    modelcheckert(_message_handler),
+    claim(_claim),
+    cache_hits(0),
+    cache_misses(0)
+  {
+  }
+
+  // A return value of TRUE means the program is correct,
+  // if FALSE is returned, counterexample will contain the counterexample
+  virtual bool check(
+    const abstract_transt &abstract_trans,
+    const abstract_transition_constrainst &abstract_transition_constrains,
+    const weakest_precondition_constrainst &weakest_precondition_constrains,
+    const abstract_initial_constrainst &abstract_initial_constrains,
+    abstract_counterexamplet &abstract_counterexample);
+
+protected:
+  bool claim;
+
+  // the manager must appear before any BDDs
+  // to do the cleanup in the right order
+  mini_bdd_mgrt mgr;
+
+  typedef mini_bddt BDD;
+
+  // one per abstract variable (predicate)
+  struct vart
+  {
+    BDD current, next;
+  };
+
+  std::vector<vart> vars;
+
+  // BDD variable number -> predicate
+  std::map<unsigned, unsigned> current_var_map;
+
+  void allocate_vars(unsigned no_vars);
+
+  BDD current_to_next(const BDD &) const;
+  BDD next_to_current(const BDD &) const;
+  BDD project_next(const BDD &) const;
+  BDD project_current(const BDD &) const;
+
+  BDD image(const BDD &states, const BDD &trans) const;
+  BDD pre_image(const BDD &states, const BDD &trans) const;
+
+  BDD cube2bdd(
+    const std::vector<unsigned> &input,
+    const std::vector<unsigned> &output,
+    const cubest::bitvt &stars,
+    const cubest::bitvt &bits) const;
+
+  BDD constraint2bdd(
+    const abstract_constraintt &start,
+    const abstract_constraintt &final) const;
+
+  BDD weakest_precondition2bdd(
+    const weakest_precondition_constrainst::value_type &) const;
+
+  BDD property2bdd(const exprt &) const;
+
+  // caches, kept across iterations
+  struct cached_clustert
+  {
+    abstract_transition_relationt cluster;
+    BDD bdd;
+  };
+
+  typedef std::vector<cached_clustert> cached_clusterst;
+  cached_clusterst trans_cache, refinement_cache;
+
+  struct cached_initt
+  {
+    abstract_initial_statest initial_states;
+    BDD bdd;
+  };
+
+  typedef std::vector<cached_initt> cached_initst;
+  cached_initst init_cache;
+
+  std::map<abstract_transition_constraintt, BDD> transition_constraint_cache;
+  std::map<abstract_constraintt, BDD> initial_constraint_cache;
+  std::map<weakest_precondition_constrainst::value_type, BDD>
+    weakest_precondition_cache;
+
+  unsigned cache_hits, cache_misses;
+
+  const BDD &cluster_bdd(
+    const abstract_transition_relationt &,
+    cached_clustert &);
+
+  const BDD &init_bdd(
+    const abstract_initial_statest &,
+    cached_initt &);
+
+  void get_state(const BDD &, abstract_statet &) const;
+
+  void compute_counterexample(
+    const std::vector<BDD> &rings,
+    const BDD &bad,
+    const BDD &trans,
+    abstract_counterexamplet &counterexample) const;
+};
+
+#endif
@@ -86,10 +86,12 @@ void vcegar_parseoptionst::help()
     " vcegar --modelchecker <num>    Which modelchecker to use for checking abstractions\n"
     "   num=nusmv                    Use NuSMV binary named NuSMV  \n"
     "   num=cadencesmv               Use Cadence SMV binary named smv (default)\n"
+    "   num=bdd                      Use the built-in BDD model checker (no external SMV)\n"
     " vcegar --absref3               Give this option to Cadence SMV              \n"
     " vcegar --gcr                   Generates clusters from refinement of spurious transitions. \n"  
     " vcegar --gcrsize <nr>          Maximum cluster size when generating clusters from refinement  \n"
     " vcegar --noinit                Do not compute initial set of abstract states\n"
+    " vcegar --num-threads <nr>      Abstract the clusters of the transition relation in <nr> threads\n"
  
    "\n"
     "Even less frequently used (use at your own risk):\n"
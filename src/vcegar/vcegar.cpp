@@ -28,6 +28,7 @@ Purpose: Counter Example Guided Abstraction refinement for Verilog
 #include <util/xml.h>
 #include <util/xml_irep.h>
 #include <util/std_expr.h>
+#include <util/string2int.h>
 
 #include <langapi/languages.h>
 #include <langapi/mode.h>
@@ -45,6 +46,7 @@ Purpose: Counter Example Guided Abstraction refinement for Verilog
 #include "discover_predicates.h"
 
 //Related to predicate abstraction
+#include "modelchecker_bdd.h"
 #include "modelchecker_smv.h"
 #include "simulator.h"
 #include "abstractor.h"
@@ -552,6 +554,8 @@ modelcheckert *vcegart::select_modelchecker(
     return new modelchecker_smvt(_message_handler,  modelchecker_smvt::NUSMV, verbose, claim, false);
   else if (name=="cadencesmv")
     return new modelchecker_smvt(_message_handler,  modelchecker_smvt::CADENCE_SMV, verbose, claim, absref3);
+  else if (name=="bdd")
+    return new modelchecker_bddt(_message_handler, claim);
   else
     throw "unknown modelchecker: "+name;
 }
@@ -591,13 +595,20 @@ int vcegart::pred_abs_init()
   concrete_trans.trans_expr = *trans_expr;
 
   //threads to create
-  int num_threads = 1;
+  unsigned num_threads = 1;
   
   if (cmdline.isset("num-threads"))
     {
-      num_threads = atoi(cmdline.get_value("num-threads"));
+      const std::string value = cmdline.get_value("num-threads");
+
+      // unsafe_string2unsigned takes "-1" and "x" as well
+      if (value.empty() ||
+	  value.find_first_not_of("0123456789") != std::string::npos)
+	throw "Expected number of threads to be greater than zero\n";
+
+      num_threads = unsafe_string2unsigned(value);
       
-      if (num_threads <= 0)
+      if (num_threads == 0)
 	throw "Expected number of threads to be greater than zero\n";
     }
   //For each property start start new predicate abstraction
@@ -619,7 +630,7 @@ int vcegart::pred_abs_init()
       refinert refiner(get_message_handler(), cmdline);
       
       // calculates abstract program
-      abstractort abstractor(get_message_handler(), cmdline);
+      abstractort abstractor(get_message_handler(), cmdline, num_threads);
       
       // model checking engine
       std::auto_ptr<modelcheckert> 
@@ -6,6 +6,7 @@ Author: Daniel Kroening, kroening@kroening.com
 
 \*******************************************************************/
 
+#include <mutex>
 #include <sstream>
 
 #include <util/suffix.h>
@@ -17,6 +18,56 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "verilog_parser.h"
 #include "verilog_preprocessor.h"
 
+/*******************************************************************\
+
+   Class: string_outbuft
+
+ Purpose: appends to a string
+
+\*******************************************************************/
+
+class string_outbuft:public std::streambuf
+{
+public:
+  explicit string_outbuft(std::string &_dest):dest(_dest)
+  {
+  }
+
+protected:
+  std::string &dest;
+
+  virtual int_type overflow(int_type ch)
+  {
+    if(ch!=traits_type::eof())
+      dest+=traits_type::to_char_type(ch);
+    return ch;
+  }
+
+  virtual std::streamsize xsputn(const char *s, std::streamsize n)
+  {
+    dest.append(s, n);
+    return n;
+  }
+};
+
+/*******************************************************************\
+
+   Class: string_inbuft
+
+ Purpose: reads a string in place
+
+\*******************************************************************/
+
+class string_inbuft:public std::streambuf
+{
+public:
+  explicit string_inbuft(const std::string &src)
+  {
+    char *begin=const_cast<char *>(src.data());
+    setg(begin, begin, begin+src.size());
+  }
+};
+
 /*******************************************************************\
 
 Function: verilog_languaget::parse
@@ -33,15 +84,49 @@ bool verilog_languaget::parse(
   std::istream &instream,
   const std::string &path)
 {
-  verilog_parser.clear();
+  // The preprocessor writes its blocks straight into this string,
+  // which the scanner then reads in place.
+  std::string preprocessed;
 
-  std::stringstream str;
+  {
+    string_outbuft outbuf(preprocessed);
+    std::ostream out(&outbuf);
 
-  if(preprocess(instream, path, str))
-    return true;
+    if(preprocess(instream, path, out))
+      return true;
+  }
+
+  return parse_preprocessed(preprocessed, path);
+}
+
+/*******************************************************************\
+
+Function: verilog_languaget::parse_preprocessed
+
+  Inputs: output of the preprocessor for the file 'path'
+
+ Outputs:
+
+ Purpose: The scanner and the parser share global state; this
+          serialises the callers, whereas preprocessing may be
+          done concurrently.
+
+\*******************************************************************/
+
+bool verilog_languaget::parse_preprocessed(
+  const std::string &preprocessed,
+  const std::string &path)
+{
+  static std::mutex parser_mutex;
+  std::lock_guard<std::mutex> lock(parser_mutex);
+
+  verilog_parser.clear();
+
+  string_inbuft inbuf(preprocessed);
+  std::istream in(&inbuf);
 
   verilog_parser.set_file(path);
-  verilog_parser.in=&str;
+  verilog_parser.in=&in;
   verilog_parser.set_message_handler(get_message_handler());
   verilog_parser.grammar=verilog_parsert::LANGUAGE;
   
@@ -77,8 +162,6 @@ bool verilog_languaget::preprocess(
   const std::string &path,
   std::ostream &outstream)
 {
-  std::stringstream str;
-
   verilog_preprocessort preprocessor(
     instream, outstream, get_message_handler(), path);
 
@@ -27,6 +27,11 @@ public:
   bool parse(
     std::istream &instream,
     const std::string &path) override;
+
+  // parse the output of preprocess()
+  bool parse_preprocessed(
+    const std::string &preprocessed,
+    const std::string &path);
              
   void dependencies(
     const std::string &module,
@@ -193,6 +193,20 @@ irep_idt verilog_typecheckt::parameterize_module(
   }
   
   const symbolt &base_symbol=it->second;
+
+  // seen these before?
+  exprt key(module_identifier);
+  key.operands()=parameter_assignments;
+
+  auto c_it=parameterize_cache.map.find(key);
+
+  if(c_it!=parameterize_cache.map.end())
+  {
+    parameterize_cache.hits++;
+    return c_it->second;
+  }
+
+  parameterize_cache.misses++;
   
   std::list<exprt> parameter_values;
   
@@ -225,6 +239,8 @@ irep_idt verilog_typecheckt::parameterize_module(
   suffix+=')';
 
   irep_idt new_module_identifier=id2string(module_identifier)+suffix;
+
+  parameterize_cache.map[key]=new_module_identifier;
   
   if(symbol_table.symbols.find(new_module_identifier)!=
      symbol_table.symbols.end())
@@ -7,6 +7,11 @@ Author: Daniel Kroening, kroening@kroening.com
 \*******************************************************************/
 
 #include <fstream>
+#include <iterator>
+#include <map>
+#include <mutex>
+
+#include <sys/stat.h>
 
 #include <util/config.h>
 
@@ -51,7 +56,7 @@ bool verilog_preprocessort::filet::get(char &ch)
 {
   state=INITIAL;
 
-  while(in->get(ch))
+  while(get_raw(ch))
   {
     if(ch=='\n')
     {
@@ -88,7 +93,7 @@ bool verilog_preprocessort::filet::get(char &ch)
         break;
 
        default:
-        in->unget();
+        unget_raw();
         ch='/';
         return true;
       }
@@ -168,49 +173,124 @@ std::string verilog_preprocessort::build_path(
 
 /*******************************************************************\
 
-Function: verilog_preprocessort::include
+Function: verilog_preprocessort::read_file
 
   Inputs:
 
  Outputs:
 
- Purpose:
+ Purpose: Files are read once per process; the same header is
+          usually included by many source files. With --batch,
+          the jobs start with the files that were preloaded, and
+          a file that was modified since is read again.
 
 \*******************************************************************/
 
-void verilog_preprocessort::include(const std::string &filename)
+verilog_preprocessort::textt verilog_preprocessort::read_file(
+  const std::string &path)
 {
+  struct cachedt
   {
-    filet tmp_file;
-    files.push_back(tmp_file);
+    textt text;
+    time_t mtime;
+    off_t size;
+  };
+
+  static std::mutex cache_mutex;
+  static std::map<std::string, cachedt> cache;
+
+  struct stat info;
+
+  if(stat(path.c_str(), &info)!=0)
+    return nullptr;
+
+  {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    std::map<std::string, cachedt>::const_iterator it=cache.find(path);
+    if(it!=cache.end() &&
+       it->second.mtime==info.st_mtime &&
+       it->second.size==info.st_size)
+      return it->second.text;
   }
 
-  filet &file=files.back();
+  std::ifstream in(path.c_str(), std::ios::binary);
 
-  file.filename=filename;
-  file.close=true;
+  if(!in)
+    return nullptr;
+
+  std::shared_ptr<std::string> text=std::make_shared<std::string>();
+
+  in.seekg(0, std::ios::end);
+  std::streampos size=in.tellg();
+  in.seekg(0, std::ios::beg);
 
-  file.in=new std::ifstream(filename.c_str());
-  if(*file.in) return;
+  if(size>0)
+  {
+    text->resize(size);
+    in.read(&(*text)[0], size);
+    text->resize(in.gcount());
+  }
+
+  std::lock_guard<std::mutex> lock(cache_mutex);
+  cachedt &cached=cache[path];
+  cached.text=text;
+  cached.mtime=info.st_mtime;
+  cached.size=info.st_size;
+  return text;
+}
 
-  delete file.in;
-  file.close=false;
+/*******************************************************************\
+
+Function: verilog_preprocessort::include
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void verilog_preprocessort::include(const std::string &filename)
+{
+  textt text=read_file(filename);
 
   // try include paths in given order
   for(std::list<std::string>::const_iterator
       it=config.verilog.include_paths.begin();
-      it!=config.verilog.include_paths.end();
+      text==nullptr && it!=config.verilog.include_paths.end();
       it++)
+    text=read_file(build_path(*it, filename));
+
+  if(text==nullptr)
   {
-    file.close=true;
-    file.in=new std::ifstream(build_path(*it, filename).c_str());
-    if(*file.in) return;
-    delete file.in;
-    file.close=false;
+    error() << "include file `" << filename << "' not found" << eom;
+    throw 0;
   }
 
-  error() << "include file `" << filename << "' not found" << eom;
-  throw 0;
+  files.push_back(filet());
+
+  filet &file=files.back();
+  file.filename=filename;
+  file.text=text;
+}
+
+/*******************************************************************\
+
+Function: verilog_preprocessort::flush_output
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void verilog_preprocessort::flush_output()
+{
+  out.write(out_buffer.data(), out_buffer.size());
+  out_buffer.clear();
 }
 
 /*******************************************************************\
@@ -229,14 +309,18 @@ void verilog_preprocessort::preprocessor()
 {
   {
     filet file;
-    file.in=&in;
     file.filename=filename;
+    file.text=std::make_shared<const std::string>(
+      std::istreambuf_iterator<char>(in),
+      std::istreambuf_iterator<char>());
     files.push_back(file);
   }
 
+  out_buffer.reserve(out_buffer_size);
+
   while(!files.empty())
   {
-    files.back().print_line(out, files.size()==1?0:2);
+    output(files.back().line_directive(files.size()==1?0:2));
 
     char ch, last_out=0;
 
@@ -256,11 +340,11 @@ void verilog_preprocessort::preprocessor()
           if(last_out=='\n' && file.last_line!=file.line &&
              ch!='\n')
           {
-            file.print_line(out, 0);
+            output(file.line_directive(0));
             file.last_line=file.line;
           }
 
-          out << ch;
+          output(ch);
           last_out=ch;
 
           if(ch=='\n') file.last_line++;
@@ -268,9 +352,11 @@ void verilog_preprocessort::preprocessor()
       }
     }
 
-    if(last_out!='\n') out << '\n';
+    if(last_out!='\n') output('\n');
     files.pop_back();
   }
+
+  flush_output();
 }
 
 /*******************************************************************\
@@ -342,13 +428,13 @@ void verilog_preprocessort::directive()
 
   char ch;
 
-  while(files.back().in->get(ch))
+  while(files.back().get_raw(ch))
   {
     if(isalnum(ch) || ch=='$' || ch=='_')
       text+=ch;
     else
     {
-      files.back().in->unget();
+      files.back().unget_raw();
       break;
     }
   }
@@ -572,7 +658,7 @@ void verilog_preprocessort::directive()
 
       // found it! replace it!
 
-      out << it->second;
+      output(it->second);
     }
   }
 }
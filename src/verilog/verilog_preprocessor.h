@@ -2,6 +2,7 @@
 #define VERILOG_PREPROCESSOR_H
 
 #include <list>
+#include <memory>
 
 #include <util/irep.h>
 #include <util/string_hash.h>
@@ -24,6 +25,13 @@ public:
 
   virtual ~verilog_preprocessort() { }
 
+  // the text of a source file, read in one go
+  typedef std::shared_ptr<const std::string> textt;
+
+  // reads the file, or returns the text read earlier;
+  // returns nullptr if the file cannot be opened
+  static textt read_file(const std::string &path);
+
 protected:
   typedef std::unordered_map<std::string, std::string, string_hash>
     definest;
@@ -34,6 +42,27 @@ protected:
   virtual void replace_macros(std::string &s);
   virtual void include(const std::string &filename);
 
+  // the output is collected and written in blocks
+  std::string out_buffer;
+  
+  void flush_output();
+
+  void output(char ch)
+  {
+    out_buffer+=ch;
+    if(out_buffer.size()>=out_buffer_size)
+      flush_output();
+  }
+
+  void output(const std::string &s)
+  {
+    out_buffer+=s;
+    if(out_buffer.size()>=out_buffer_size)
+      flush_output();
+  }
+
+  static const std::size_t out_buffer_size=1<<20;
+
   static std::string build_path(
     const std::string &path,
     const std::string &filename);
@@ -66,17 +95,29 @@ protected:
   class filet
   {
   public:
-    bool close;
-    std::istream *in;
+    textt text;
+    std::size_t pos;
     std::string filename;
     unsigned line, last_line;
     
-    filet() { close=false; line=1; last_line=0; column=1; }
-    ~filet() { if(close) delete in; }
+    filet() { pos=0; line=1; last_line=0; column=1; }
     
     bool get(char &ch);
     void getline(std::string &dest);
 
+    // the next character, without the scanner below
+    bool get_raw(char &ch)
+    {
+      if(pos>=text->size()) return false;
+      ch=(*text)[pos++];
+      return true;
+    }
+
+    void unget_raw()
+    {
+      pos--;
+    }
+
     // a minimal scanner
     
     typedef enum { INITIAL, C_COMMENT, CPP_COMMENT,
@@ -86,9 +127,9 @@ protected:
     unsigned column;
     bool cpp_comment_empty;
 
-    void print_line(std::ostream &out, unsigned level)
-    { out << "`line " << line << " \"" 
-          <<filename << "\" " << level << std::endl; }
+    std::string line_directive(unsigned level) const
+    { return "`line "+std::to_string(line)+" \""+
+             filename+"\" "+std::to_string(level)+"\n"; }
   };
 
   std::list<filet> files;  
@@ -10,6 +10,7 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <map>
 #include <set>
+#include <unordered_map>
 
 #include <util/ebmc_util.h>
 #include <util/expr_util.h>
@@ -849,7 +850,7 @@ const symbolt &verilog_synthesist::assignment_symbol(const exprt &lhs)
 
 /*******************************************************************\
 
-Function: verilog_synthesist::replace_symbols
+Function: replace_symbols_rec
 
   Inputs:
 
@@ -859,36 +860,40 @@ Function: verilog_synthesist::replace_symbols
 
 \*******************************************************************/
 
-bool verilog_synthesist::replace_symbols(
-  const replace_mapt &what,
-  exprt &dest)
-{
-  bool result=true;
+// the original is kept to keep the key valid
+typedef std::unordered_map<const void *, std::pair<exprt, exprt> >
+  replace_symbols_cachet;
 
-  if(dest.id()==ID_next_symbol ||
-     dest.id()==ID_symbol)
+static void replace_symbols_rec(
+  const irep_idt &target,
+  exprt &dest,
+  replace_symbols_cachet &cache)
+{
+  if(dest.id()==ID_symbol)
   {
-    replace_mapt::const_iterator it=
-      what.find(dest.get(ID_identifier));
+    dest.id(target);
+    return;
+  }
 
-    if(it!=what.end())
-    {
-      bool is_next_symbol=dest.id()==ID_next_symbol;
-      dest=it->second;      
+  if(!dest.has_operands())
+    return;
 
-      if(is_next_symbol)
-        replace_symbols(ID_next_symbol, dest);
+  // a subtree that is shared is done once
+  replace_symbols_cachet::const_iterator c_it=cache.find(&dest.read());
 
-      result=false;
-    }
-  }
-  else
+  if(c_it!=cache.end())
   {
-    Forall_operands(it, dest)
-      result=replace_symbols(what, *it) && result;
+    dest=c_it->second.second;
+    return;
   }
 
-  return result;
+  exprt original=dest;
+
+  Forall_operands(it, dest)
+    replace_symbols_rec(target, *it, cache);
+
+  cache.insert(
+    std::make_pair(&original.read(), std::make_pair(original, dest)));
 }
 
 /*******************************************************************\
@@ -899,7 +904,8 @@ Function: verilog_synthesist::replace_symbols
 
  Outputs:
 
- Purpose:
+ Purpose: turn the symbols into the given kind,
+          e.g., next_symbol
 
 \*******************************************************************/
 
@@ -907,11 +913,8 @@ void verilog_synthesist::replace_symbols(
   const irep_idt &target,
   exprt &dest)
 {
-  if(dest.id()==ID_symbol)
-    dest.id(target);
-  else
-    Forall_operands(it, dest)
-      replace_symbols(target, *it);
+  replace_symbols_cachet cache;
+  replace_symbols_rec(target, dest, cache);
 }
 
 /*******************************************************************\
@@ -1216,6 +1219,106 @@ void verilog_synthesist::synth_module_instance_builtin(
 
 /*******************************************************************\
 
+Function: verilog_synthesist::module_template
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+const verilog_synthesist::module_templatet &
+verilog_synthesist::module_template(const symbolt &symbol)
+{
+  module_templatest::iterator t_it=module_templates.find(symbol.name);
+
+  if(t_it!=module_templates.end())
+    return t_it->second;
+
+  module_templatet &module_template=module_templates[symbol.name];
+
+  for(auto it=symbol_table.symbol_module_map.lower_bound(symbol.module);
+      it!=symbol_table.symbol_module_map.upper_bound(symbol.module);
+      it++)
+  {
+    const symbolt &module_symbol=ns.lookup(it->second);
+
+    if(module_symbol.type.id()!=ID_module)
+    {
+      // strip old module
+      module_template.symbols.push_back(
+        std::pair<irep_idt, std::string>(
+          module_symbol.name,
+          std::string(id2string(module_symbol.name), symbol.module.size())));
+    }
+  }
+
+  return module_template;
+}
+
+/*******************************************************************\
+
+Function: verilog_synthesist::instantiate_template
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+exprt verilog_synthesist::instantiate_template(
+  const exprt &src,
+  const replace_mapt &what,
+  instantiate_cachet &cache)
+{
+  if(src.id()==ID_next_symbol ||
+     src.id()==ID_symbol)
+  {
+    replace_mapt::const_iterator it=
+      what.find(src.get(ID_identifier));
+
+    if(it==what.end())
+      return src;
+
+    exprt dest=it->second;
+
+    if(src.id()==ID_next_symbol)
+      replace_symbols(ID_next_symbol, dest);
+
+    return dest;
+  }
+
+  if(!src.has_operands())
+    return src;
+
+  instantiate_cachet::const_iterator c_it=cache.find(&src.read());
+
+  if(c_it!=cache.end())
+    return c_it->second;
+
+  exprt dest=src;
+
+  for(std::size_t i=0; i<src.operands().size(); i++)
+  {
+    const exprt &op=src.operands()[i];
+    exprt new_op=instantiate_template(op, what, cache);
+
+    // only unshare what has changed
+    if(&new_op.read()!=&op.read())
+      dest.operands()[i].swap(new_op);
+  }
+
+  cache.insert(std::make_pair(&src.read(), dest));
+
+  return dest;
+}
+
+/*******************************************************************\
+
 Function: verilog_synthesist::expand_module_instance
 
   Inputs:
@@ -1235,70 +1338,64 @@ void verilog_synthesist::expand_module_instance(
 
   const irep_idt &instance=op.get(ID_instance);
 
-  replace_mapt replace_map;
+  const module_templatet &module_template=this->module_template(symbol);
 
-  std::list<irep_idt> new_symbols;
+  // Identifiers are Verilog::MODULE.id.id.id
+  const std::string prefix=
+    id2string(mode)+"::"+
+    id2string(verilog_module_name(module))+
+    "."+id2string(instance);
 
-  for(auto it=symbol_table.symbol_module_map.lower_bound(symbol.module);
-      it!=symbol_table.symbol_module_map.upper_bound(symbol.module);
-      it++)
-  {
-    const symbolt &symbol=ns.lookup(it->second);
-    
-    if(symbol.type.id()!=ID_module)
-    {
-      // instantiate the symbol
+  replace_mapt replace_map;
 
-      symbolt new_symbol(symbol);
+  std::vector<irep_idt> new_symbols;
+  new_symbols.reserve(module_template.symbols.size());
 
-      new_symbol.module=module;
-      
-      // Identifiers are Verilog::MODULE.id.id.id
+  for(const auto &template_symbol : module_template.symbols)
+  {
+    // instantiate the symbol
 
-      // strip old module      
-      std::string identifier_without_module=
-        std::string(id2string(symbol.name), symbol.module.size());
+    symbolt new_symbol(ns.lookup(template_symbol.first));
 
-      std::string full_identifier;
+    new_symbol.module=module;
 
-      full_identifier=id2string(mode)+"::";
-      full_identifier+=id2string(verilog_module_name(module));
-      full_identifier+="."+id2string(instance);
-      full_identifier+=identifier_without_module;
+    const std::string full_identifier=prefix+template_symbol.second;
 
-      new_symbol.pretty_name=strip_verilog_prefix(full_identifier);
-      new_symbol.name=full_identifier;
+    new_symbol.pretty_name=strip_verilog_prefix(full_identifier);
+    new_symbol.name=full_identifier;
 
-      if(symbol_table.add(new_symbol))
-      {
-        error() << "name collision during module instantiation: "
-                << new_symbol.name << eom;
-        throw 0;
-      }
+    if(symbol_table.add(new_symbol))
+    {
+      error() << "name collision during module instantiation: "
+              << new_symbol.name << eom;
+      throw 0;
+    }
 
-      new_symbols.push_back(new_symbol.name);
+    new_symbols.push_back(new_symbol.name);
 
-      // build replace map
+    // build replace map
 
-      std::pair<irep_idt, exprt> replace_pair;
-      replace_pair.first=symbol.name;
-      replace_pair.second=symbol_expr(new_symbol, CURRENT);
-      replace_map.insert(replace_pair);
-    }
+    replace_map.insert(std::pair<irep_idt, exprt>(
+      template_symbol.first, symbol_expr(new_symbol, CURRENT)));
   }
 
+  // the macros and the trans share subtrees
+  instantiate_cachet cache;
+
   // replace identifiers in macros
 
   for(const auto & it : new_symbols)
   {
     symbolt &symbol=symbol_table_lookup(it);
-    replace_symbols(replace_map, symbol.value);
+
+    if(symbol.value.is_not_nil())
+      symbol.value=instantiate_template(symbol.value, replace_map, cache);
   }
 
   // do the trans
 
   {
-    exprt tmp=symbol.value;
+    const exprt &tmp=symbol.value;
 
     if(tmp.id()!=ID_trans || tmp.operands().size()!=3)
     {
@@ -1308,10 +1405,13 @@ void verilog_synthesist::expand_module_instance(
       throw 0;
     }
 
-    replace_symbols(replace_map, tmp);
-
     for(unsigned i=0; i<3; i++)
-      trans.operands()[i].move_to_operands(tmp.operands()[i]);
+    {
+      exprt instantiated=
+        instantiate_template(tmp.operands()[i], replace_map, cache);
+
+      trans.operands()[i].move_to_operands(instantiated);
+    }
   }
 
   instantiate_ports(instance, op, symbol, replace_map, trans);
@@ -2244,6 +2344,10 @@ void verilog_synthesist::synth_for(const verilog_fort &statement)
 
   synth_statement(statement.initialization());
 
+  // try without unrolling first
+  if(!synth_for_symbolic(statement))
+    return;
+
   while(true)
   {  
     exprt tmp_guard=statement.condition();
@@ -2272,6 +2376,305 @@ void verilog_synthesist::synth_for(const verilog_fort &statement)
 
 /*******************************************************************\
 
+Function: is_loop_variable
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: the expression is the loop variable, possibly with casts
+
+\*******************************************************************/
+
+static bool is_loop_variable(
+  const exprt &expr,
+  const irep_idt &identifier)
+{
+  if(expr.id()==ID_typecast)
+    return is_loop_variable(to_typecast_expr(expr).op(), identifier);
+
+  return expr.id()==ID_symbol &&
+         to_symbol_expr(expr).get_identifier()==identifier;
+}
+
+/*******************************************************************\
+
+Function: replace_loop_variable
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+static void replace_loop_variable(
+  exprt &expr,
+  const irep_idt &identifier,
+  const exprt &by)
+{
+  if(expr.id()==ID_symbol &&
+     to_symbol_expr(expr).get_identifier()==identifier)
+    expr=typecast_exprt::conditional_cast(by, expr.type());
+  else
+    Forall_operands(it, expr)
+      replace_loop_variable(*it, identifier, by);
+}
+
+/*******************************************************************\
+
+Function: replace_placeholder
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+static void replace_placeholder(
+  exprt &expr,
+  const symbol_exprt &by)
+{
+  if(expr.id()==ID_nondet_symbol &&
+     expr.get(ID_identifier)==by.get_identifier())
+    expr=by;
+  else
+    Forall_operands(it, expr)
+      replace_placeholder(*it, by);
+}
+
+/*******************************************************************\
+
+Function: reads_array
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: the expression reads the array other than at the
+          index given by the loop variable
+
+\*******************************************************************/
+
+static bool reads_array(
+  const exprt &expr,
+  const irep_idt &array,
+  const irep_idt &loop_variable)
+{
+  if(expr.id()==ID_index &&
+     expr.operands().size()==2 &&
+     expr.op0().id()==ID_symbol &&
+     to_symbol_expr(expr.op0()).get_identifier()==array &&
+     is_loop_variable(expr.op1(), loop_variable))
+    return false;
+
+  if(expr.id()==ID_symbol)
+    return to_symbol_expr(expr).get_identifier()==array;
+
+  forall_operands(it, expr)
+    if(reads_array(*it, array, loop_variable))
+      return true;
+
+  return false;
+}
+
+/*******************************************************************\
+
+Function: verilog_synthesist::synth_for_symbolic
+
+  Inputs: a for-loop whose initialization has been done
+
+ Outputs: true if the loop does not have the expected shape
+
+ Purpose: Loops of the form
+
+            for(i=from; i<to; i++) a[i]=f(i);
+
+          where the body may be a block of such assignments to
+          distinct arrays, are done in one step: a becomes the
+          array that is f(j) for j in [from, to) and a[j]
+          otherwise. f may read these arrays at i only, as in
+          a[i]=a[i]+1 or a[i]=b[i]; b[i]=a[i]. Anything else is
+          unrolled by the caller.
+
+\*******************************************************************/
+
+bool verilog_synthesist::synth_for_symbolic(const verilog_fort &statement)
+{
+  const verilog_statementt &initialization=statement.initialization();
+
+  if(initialization.id()!=ID_blocking_assign ||
+     initialization.operands().size()!=2 ||
+     initialization.op0().id()!=ID_symbol)
+    return true;
+
+  const irep_idt loop_variable=
+    to_symbol_expr(initialization.op0()).get_identifier();
+
+  // only integers are elaborated
+  valuest::iterator v_it=values.find(loop_variable);
+  if(v_it==values.end())
+    return true;
+
+  const exprt &condition=statement.condition();
+
+  if((condition.id()!=ID_lt &&
+      condition.id()!=ID_le &&
+      condition.id()!=ID_notequal) ||
+     condition.operands().size()!=2 ||
+     !is_loop_variable(condition.op0(), loop_variable))
+    return true;
+
+  {
+    has_symbol_cachet cache;
+    if(has_symbol(loop_variable, condition.op1(), cache))
+      return true;
+  }
+
+  const verilog_statementt &inc_statement=statement.inc_statement();
+
+  if(inc_statement.id()!=ID_blocking_assign &&
+     inc_statement.id()!=ID_preincrement &&
+     inc_statement.id()!=ID_postincrement)
+    return true;
+
+  if(inc_statement.operands().empty() ||
+     !is_loop_variable(inc_statement.op0(), loop_variable))
+    return true;
+
+  // collect the assignments in the body
+  std::vector<const exprt *> body;
+
+  if(statement.body().id()==ID_block)
+  {
+    forall_operands(it, statement.body())
+      body.push_back(&(*it));
+  }
+  else
+    body.push_back(&statement.body());
+
+  std::set<irep_idt> arrays;
+
+  for(const auto assign : body)
+  {
+    if((assign->id()!=ID_blocking_assign &&
+        assign->id()!=ID_non_blocking_assign) ||
+       assign->operands().size()!=2)
+      return true;
+
+    const exprt &lhs=assign->op0();
+
+    if(lhs.id()!=ID_index ||
+       lhs.operands().size()!=2 ||
+       lhs.op0().id()!=ID_symbol ||
+       lhs.op0().type().id()!=ID_array ||
+       !is_loop_variable(lhs.op1(), loop_variable))
+      return true;
+
+    if(!arrays.insert(to_symbol_expr(lhs.op0()).get_identifier()).second)
+      return true;
+  }
+
+  for(const auto assign : body)
+  {
+    const exprt &rhs=assign->op1();
+
+    if(has_subexpr(rhs, ID_function_call) ||
+       has_subexpr(rhs, ID_hierarchical_identifier))
+      return true;
+
+    for(const auto &array : arrays)
+      if(reads_array(rhs, array, loop_variable))
+        return true;
+  }
+
+  // now the range
+  const mp_integer from=v_it->second;
+
+  exprt bound=condition.op1();
+  synth_expr(bound, symbol_statet::CURRENT);
+  simplify(bound, ns);
+
+  mp_integer to;
+  if(to_integer(bound, to))
+    return true;
+
+  if(condition.id()==ID_le)
+    ++to;
+
+  if(from<0 || to<=from)
+    return true;
+
+  // the increment must be by one
+  synth_statement(inc_statement);
+  bool by_one=values[loop_variable]==from+1;
+  values[loop_variable]=from;
+
+  if(!by_one)
+    return true;
+
+  for(const auto assign : body)
+  {
+    mp_integer size;
+    const array_typet &array_type=to_array_type(assign->op0().op0().type());
+
+    if(to_integer(array_type.size(), size) || to>size)
+      return true;
+  }
+
+  // no more failures from here on
+  for(const auto assign : body)
+  {
+    const exprt &lhs=assign->op0();
+    const symbol_exprt &array=to_symbol_expr(lhs.op0());
+    const typet &index_type=lhs.op1().type();
+
+    symbol_exprt index(
+      id2string(module)+"::loop_index"+std::to_string(temporary_counter++),
+      index_type);
+
+    // the loop variable is not a symbol to synth_expr
+    exprt rhs=assign->op1();
+    replace_loop_variable(
+      rhs, loop_variable,
+      nondet_symbol_exprt(index.get_identifier(), index_type));
+    synth_expr(rhs, symbol_statet::CURRENT);
+    replace_placeholder(rhs, index);
+
+    exprt old_value=array;
+    synth_expr(old_value, symbol_statet::FINAL);
+
+    and_exprt in_range(
+      binary_relation_exprt(index, ID_ge, from_integer(from, index_type)),
+      binary_relation_exprt(index, ID_le, from_integer(to-1, index_type)));
+
+    if_exprt element(
+      in_range,
+      typecast_exprt::conditional_cast(rhs, lhs.type()),
+      index_exprt(old_value, index));
+
+    // this counts as an assignment to the whole array
+    assignment(
+      array,
+      array_comprehension_exprt(
+        index, element, to_array_type(array.type())),
+      assign->id()==ID_blocking_assign);
+  }
+
+  // the value on exit
+  values[loop_variable]=to;
+
+  statistics() << "Loop with " << to-from
+               << " iterations synthesized without unrolling" << eom;
+
+  return false;
+}
+
+/*******************************************************************\
+
 Function: verilog_synthesist::synth_prepostincdec
 
   Inputs:
@@ -2813,22 +3216,42 @@ exprt verilog_synthesist::current_value(
 
 /*******************************************************************\
 
-Function: subexpressions
+Function: count_nondet_symbols
 
   Inputs:
 
  Outputs:
 
- Purpose:
+ Purpose: Counts the occurrences of the nondet_symbols, up to two.
+          A subtree that is shared is walked at most twice, as
+          everything in it is then known to occur twice.
 
 \*******************************************************************/
 
-void subexpressions(const exprt &expr, std::multiset<exprt> &counters)
+typedef std::unordered_map<exprt, unsigned, irep_hash> nondet_countst;
+typedef std::unordered_map<const void *, unsigned> visitst;
+
+static void count_nondet_symbols(
+  const exprt &expr,
+  nondet_countst &counts,
+  visitst &visits)
 {
-  counters.insert(expr);
+  unsigned &visited=visits[&expr.read()];
+
+  if(visited>=2)
+    return;
+
+  visited++;
+
+  if(expr.id()==ID_nondet_symbol)
+  {
+    unsigned &count=counts[expr];
+    if(count<2)
+      count++;
+  }
 
   forall_operands(it, expr)
-    subexpressions(*it, counters);
+    count_nondet_symbols(*it, counts, visits);
 }
 
 /*******************************************************************\
@@ -2847,10 +3270,11 @@ void verilog_synthesist::post_process_initial(exprt &constraints)
 {
   // look for unused non-determinism constraints
   
-  std::multiset<exprt> counters;
+  nondet_countst counts;
+  visitst visits;
 
   forall_operands(it, constraints)
-    subexpressions(*it, counters);
+    count_nondet_symbols(*it, counts, visits);
 
   Forall_operands(it, constraints)
   {
@@ -2868,7 +3292,7 @@ void verilog_synthesist::post_process_initial(exprt &constraints)
          rhs.id()==ID_nondet_symbol)
       #endif
       {
-        if(counters.count(rhs)==1)
+        if(counts[rhs]==1)
         {
           // not used elsewhere
           it->set(ID_value, ID_true);
@@ -2896,8 +3320,32 @@ void verilog_synthesist::post_process_wire(
 {
   // look if wire is used to define wire itself
 
+  has_symbol_cachet cache;
+  post_process_wire(identifier, expr, cache);
+}
+
+/*******************************************************************\
+
+Function: verilog_synthesist::post_process_wire
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: only the subtrees that refer to the wire are unshared
+
+\*******************************************************************/
+
+void verilog_synthesist::post_process_wire(
+  const irep_idt &identifier,
+  exprt &expr,
+  has_symbol_cachet &cache)
+{
+  if(!has_symbol(identifier, expr, cache))
+    return;
+
   Forall_operands(it, expr)
-    post_process_wire(identifier, *it);
+    post_process_wire(identifier, *it, cache);
 
   if(expr.id()==ID_symbol && 
      expr.get(ID_identifier)==identifier)
@@ -2908,6 +3356,48 @@ void verilog_synthesist::post_process_wire(
 
 /*******************************************************************\
 
+Function: verilog_synthesist::has_symbol
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+bool verilog_synthesist::has_symbol(
+  const irep_idt &identifier,
+  const exprt &expr,
+  has_symbol_cachet &cache)
+{
+  if(expr.id()==ID_symbol)
+    return expr.get(ID_identifier)==identifier;
+
+  if(!expr.has_operands())
+    return false;
+
+  has_symbol_cachet::const_iterator c_it=cache.find(&expr.read());
+
+  if(c_it!=cache.end())
+    return c_it->second;
+
+  bool result=false;
+
+  forall_operands(it, expr)
+    if(has_symbol(identifier, *it, cache))
+    {
+      result=true;
+      break;
+    }
+
+  cache[&expr.read()]=result;
+
+  return result;
+}
+
+/*******************************************************************\
+
 Function: verilog_synthesist::convert_module_items
 
   Inputs:
@@ -11,7 +11,9 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <cassert>
 #include <map>
+#include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include <util/mathematical_expr.h>
 #include <util/mp_arith.h>
@@ -219,6 +221,7 @@ protected:
   void synth_event_guard(const class verilog_event_guardt &);
   void synth_delay(const class verilog_delayt &);
   void synth_for(const class verilog_fort &);
+  bool synth_for_symbolic(const class verilog_fort &);
   void synth_force(const class verilog_forcet &);
   void synth_force_rec(const exprt &lhs, const exprt &rhs);
   void synth_forever(const class verilog_forevert &);
@@ -234,6 +237,19 @@ protected:
 
   void post_process_initial(exprt &constraints);
   void post_process_wire(const irep_idt &identifier, exprt &expr);
+
+  // whether a subtree refers to the wire, by shared subtree
+  typedef std::unordered_map<const void *, bool> has_symbol_cachet;
+
+  static bool has_symbol(
+    const irep_idt &identifier,
+    const exprt &expr,
+    has_symbol_cachet &cache);
+
+  void post_process_wire(
+    const irep_idt &identifier,
+    exprt &expr,
+    has_symbol_cachet &cache);
   
   exprt case_comparison(const exprt &case_operand, const exprt &pattern);
   
@@ -275,8 +291,30 @@ protected:
     const replace_mapt &replace_map,
     transt &trans);
 
-  bool replace_symbols(const replace_mapt &what, exprt &dest);
   void replace_symbols(const irep_idt &target, exprt &dest);
+
+  // The symbols of an instantiated module are collected once,
+  // and are then stamped out for every instance.
+  struct module_templatet
+  {
+    // the name of the symbol, and the name without the module
+    std::vector<std::pair<irep_idt, std::string> > symbols;
+  };
+
+  typedef std::map<irep_idt, module_templatet> module_templatest;
+  module_templatest module_templates;
+
+  const module_templatet &module_template(const symbolt &);
+
+  // Replaces the symbols of the module by those of the instance.
+  // Unchanged subtrees stay shared, and a subtree that is shared
+  // in 'src' is done only once.
+  typedef std::unordered_map<const void *, exprt> instantiate_cachet;
+
+  exprt instantiate_template(
+    const exprt &src,
+    const replace_mapt &what,
+    instantiate_cachet &cache);
   
   void instantiate_port(
     const exprt &symbol_expr,
@@ -364,17 +364,6 @@ exprt verilog_typecheckt::elaborate_const_function_call(
   const symbolt &function_symbol=
     ns.lookup(to_symbol_expr(function_call.function()));
 
-  // typecheck it
-  verilog_declt decl=to_verilog_decl(function_symbol.value);
-
-  irept::subt &declarations=decl.declarations();
-
-  Forall_irep(it, declarations)
-    convert_decl(static_cast<verilog_declt &>(*it));
-
-  function_or_task_name=function_symbol.name;
-  convert_statement(decl.body());
-  
   const code_typet &code_type=
     to_code_type(function_symbol.type);
 
@@ -388,28 +377,57 @@ exprt verilog_typecheckt::elaborate_const_function_call(
     throw 0;
   }
   
-  // elaborate the arguments of the call and assign to parameter
-  
-  varst old_vars;
-  
-  for(std::size_t i=0; i<arguments.size(); i++)
+  // elaborate the arguments of the call
+
+  function_call_exprt key(function_call);
+
+  for(auto &argument : key.arguments())
   {
-    exprt value=elaborate_const_expression(arguments[i]);
+    exprt value=elaborate_const_expression(argument);
 
     if(!value.is_constant())
     {
-      error().source_location=arguments[i].source_location();
+      error().source_location=argument.source_location();
       error() << "constant function argument is not constant" << eom;
       throw 0;
     }
-    
+
+    argument=value;
+  }
+
+  // constant functions only depend on their arguments
+  auto c_it=function_call_cache.map.find(key);
+
+  if(c_it!=function_call_cache.map.end())
+  {
+    function_call_cache.hits++;
+    return c_it->second;
+  }
+
+  function_call_cache.misses++;
+
+  // typecheck it
+  verilog_declt decl=to_verilog_decl(function_symbol.value);
+
+  irept::subt &declarations=decl.declarations();
+
+  Forall_irep(it, declarations)
+    convert_decl(static_cast<verilog_declt &>(*it));
+
+  function_or_task_name=function_symbol.name;
+  convert_statement(decl.body());
+  
+  // assign the arguments to the parameters
+  
+  for(std::size_t i=0; i<arguments.size(); i++)
+  {
     irep_idt p_identifier=parameters[i].get_identifier();
 
-    old_vars[p_identifier]=var_value(p_identifier);
-    vars[p_identifier]=value;
+    vars[p_identifier]=key.arguments()[i];
     
     #if 0
-    status() << "ASSIGN " << p_identifier << " <- " << to_string(value) << eom;
+    status() << "ASSIGN " << p_identifier << " <- "
+             << to_string(key.arguments()[i]) << eom;
     #endif
   }
 
@@ -424,6 +442,8 @@ exprt verilog_typecheckt::elaborate_const_function_call(
     id2string(function_symbol.name)+"."+
     id2string(function_symbol.base_name));
 
+  function_call_cache.map[key]=return_value;
+
   return return_value;
 }
 
@@ -1621,6 +1641,44 @@ void verilog_typecheckt::typecheck()
 {
   module_interface();
   convert_statements();
+  show_elaboration_statistics();
+}
+
+/*******************************************************************\
+
+Function: verilog_typecheckt::show_elaboration_statistics
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void verilog_typecheckt::show_elaboration_statistics()
+{
+  const std::size_t hits=
+    const_expression_cache.hits+
+    function_call_cache.hits+
+    parameterize_cache.hits;
+
+  const std::size_t misses=
+    const_expression_cache.misses+
+    function_call_cache.misses+
+    parameterize_cache.misses;
+
+  if(hits+misses==0)
+    return;
+
+  statistics() << "Elaboration of " << module_symbol.base_name << ": "
+               << hits << " cache hits, " << misses << " misses ("
+               << const_expression_cache.hits << '/'
+               << const_expression_cache.misses << " constants, "
+               << function_call_cache.hits << '/'
+               << function_call_cache.misses << " function calls, "
+               << parameterize_cache.hits << '/'
+               << parameterize_cache.misses << " instances)" << eom;
 }
 
 /*******************************************************************\
@@ -84,6 +84,9 @@ protected:
     irept &module_source,
     const std::list<exprt> &parameter_values);
 
+  // the base module with the parameter assignments -> the instance
+  elaboration_cachet<irep_idt> parameterize_cache;
+
   // interfaces
   void module_interface();
   void interface_ports(irept::subt &ports);
@@ -205,6 +208,11 @@ protected:
 
   // const functions
   exprt elaborate_const_function_call(const class function_call_exprt &) override;
+
+  // the call with the values of the arguments -> the return value
+  elaboration_cachet<exprt> function_call_cache;
+
+  void show_elaboration_statistics();
   void verilog_interpreter(const class verilog_statementt &);
   
   // counter for assertions
@@ -1089,20 +1089,83 @@ void verilog_typecheck_exprt::convert_const_expression(
 
   // this could be large
   propagate_type(tmp, integer_typet());
-  
-  tmp=elaborate_const_expression(tmp);
 
-  if(tmp.is_true())
+  // Genvars are constants by now, and follow_macros has put in
+  // the values of the parameters. A parameter that is left is
+  // fixed for this module, and the cache belongs to the module,
+  // i.e., to one set of parameter values. The value of anything
+  // else may change while interpreting a function.
+  const bool cacheable=!has_variable(tmp);
+
+  if(cacheable)
+  {
+    auto c_it=const_expression_cache.map.find(tmp);
+
+    if(c_it!=const_expression_cache.map.end())
+    {
+      const_expression_cache.hits++;
+      value=c_it->second;
+      return;
+    }
+
+    const_expression_cache.misses++;
+  }
+
+  exprt elaborated=elaborate_const_expression(tmp);
+
+  if(elaborated.is_true())
     value=1;
-  else if(tmp.is_false())
+  else if(elaborated.is_false())
     value=0;
-  else if(to_integer(tmp, value))
+  else if(to_integer(elaborated, value))
   {
     error().source_location=expr.source_location();
     error() << "expected constant expression, but got `"
-            << to_string(tmp) << '\'' << eom;
+            << to_string(elaborated) << '\'' << eom;
     throw 0;
   }
+
+  if(cacheable)
+    const_expression_cache.map[tmp]=value;
+}
+
+/*******************************************************************\
+
+Function: verilog_typecheck_exprt::has_variable
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: whether the expression refers to a symbol other than
+          a parameter, not counting the names of called functions
+
+\*******************************************************************/
+
+bool verilog_typecheck_exprt::has_variable(const exprt &expr) const
+{
+  if(expr.id()==ID_symbol)
+  {
+    const symbolt *symbol;
+
+    // parameters are macros
+    return ns.lookup(to_symbol_expr(expr).get_identifier(), symbol) ||
+           !symbol->is_macro;
+  }
+  else if(expr.id()==ID_function_call)
+  {
+    for(const auto &argument : to_function_call_expr(expr).arguments())
+      if(has_variable(argument))
+        return true;
+
+    return false;
+  }
+
+  for(const auto &op : expr.operands())
+    if(has_variable(op))
+      return true;
+
+  return false;
 }
 
 /*******************************************************************\
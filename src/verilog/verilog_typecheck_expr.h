@@ -12,7 +12,9 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <cassert>
 
 #include <stack>
+#include <unordered_map>
 
+#include <util/irep_hash.h>
 #include <util/mp_arith.h>
 #include <util/namespace.h>
 #include <util/std_expr.h>
@@ -83,6 +85,26 @@ protected:
   bool is_const_expression(const exprt &, mp_integer &value);
   exprt elaborate_const_expression(const exprt &);
 
+  // Memo tables for elaboration. There is one typechecker per module,
+  // and a parameterised module is a module of its own; hence, the
+  // module and the parameter values are implicit in the key.
+  template<typename valuet>
+  struct elaboration_cachet
+  {
+    typedef std::unordered_map<exprt, valuet, irep_hash> mapt;
+    mapt map;
+    std::size_t hits, misses;
+
+    elaboration_cachet():hits(0), misses(0)
+    {
+    }
+  };
+
+  // keyed on the expression after type checking
+  elaboration_cachet<mp_integer> const_expression_cache;
+
+  bool has_variable(const exprt &) const;
+
   // to be overridden
   virtual exprt elaborate_const_function_call(const class function_call_exprt &)
   {